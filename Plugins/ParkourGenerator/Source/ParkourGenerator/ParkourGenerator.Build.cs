@@ -25,25 +25,36 @@ public class ParkourGenerator : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"InputCore",
-				"ProceduralMeshComponent"
+				"ProceduralMeshComponent",
+				"DeveloperSettings"
 			}
 		);
 
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Slate",
-				"SlateCore",
-				"UnrealEd",
-				"EditorStyle",
-				"EditorSubsystem",
-				"LevelEditor",
-				"PropertyEditor",
-				"EditorFramework",
-				"ToolMenus"
+				"PhysicsCore",
+				"RenderCore",
+				"Json",
+				"NavigationSystem"
 			}
 		);
 
+		// Baking and the generation cache are editor only (WITH_EDITOR), the module itself ships in games
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"UnrealEd",
+					"MeshDescription",
+					"StaticMeshDescription",
+					"AssetRegistry",
+					"DerivedDataCache"
+				}
+			);
+		}
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -0,0 +1,212 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourGenerationCache.h"
+
+#if WITH_EDITOR
+
+#include "ParkourPath.h"
+#include "ParkourPlayArea.h"
+#include "ParkourReachabilityTable.h"
+#include "ParkourGeneratorSettings.h"
+#include "DerivedDataCacheInterface.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/SecureHash.h"
+
+namespace ParkourGenerationCache
+{
+	/** Change whenever the solvers produce different output for the same inputs */
+	static const TCHAR* Version = TEXT("029CD02AF3C44E9285CB90D61A564F61");
+
+	static const TCHAR* DataContext = TEXT("ParkourGenerator");
+
+	static bool IsEnabled()
+	{
+		const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+		return Settings && Settings->bUseGenerationCache;
+	}
+
+	template<typename ValueType>
+	static void HashValue(FArchive& Ar, ValueType Value)
+	{
+		Ar << Value;
+	}
+}
+
+void FParkourGenerationCache::HashSpline(FArchive& Ar, const USplineComponent* Spline)
+{
+	const int32 NumPoints = Spline ? Spline->GetNumberOfSplinePoints() : 0;
+	ParkourGenerationCache::HashValue(Ar, NumPoints);
+	ParkourGenerationCache::HashValue(Ar, Spline && Spline->IsClosedLoop());
+
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		ParkourGenerationCache::HashValue(Ar, Spline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World));
+		ParkourGenerationCache::HashValue(Ar, Spline->GetArriveTangentAtSplinePoint(i, ESplineCoordinateSpace::World));
+		ParkourGenerationCache::HashValue(Ar, Spline->GetLeaveTangentAtSplinePoint(i, ESplineCoordinateSpace::World));
+		ParkourGenerationCache::HashValue(Ar, (uint8)Spline->GetSplinePointType(i));
+	}
+}
+
+void FParkourGenerationCache::HashPathInputs(FArchive& Ar, const AParkourPath& Path)
+{
+	HashSpline(Ar, Path.PathSpline);
+
+	ParkourGenerationCache::HashValue(Ar, Path.MaxJumpHeight);
+	ParkourGenerationCache::HashValue(Ar, Path.MaxJumpDistance);
+	ParkourGenerationCache::HashValue(Ar, Path.JumpSafetyMargin);
+
+	// A baked table replaces the jump limits
+	const bool bReachabilityTable = Path.UsesReachabilityTable();
+	ParkourGenerationCache::HashValue(Ar, bReachabilityTable);
+	if (bReachabilityTable)
+	{
+		ParkourGenerationCache::HashValue(Ar, Path.ReachabilityTable->GetTableHash());
+		ParkourGenerationCache::HashValue(Ar, Path.ReachabilityTable->BakedMaxJumpDistance);
+		ParkourGenerationCache::HashValue(Ar, Path.ReachabilityTable->BakedMaxJumpHeight);
+		ParkourGenerationCache::HashValue(Ar, Path.ReachabilityTable->BakedMaxReach);
+	}
+	ParkourGenerationCache::HashValue(Ar, Path.PlatformWidth);
+	ParkourGenerationCache::HashValue(Ar, Path.PlatformDepth);
+	ParkourGenerationCache::HashValue(Ar, Path.PlatformThickness);
+	ParkourGenerationCache::HashValue(Ar, Path.MinPlatforms);
+	ParkourGenerationCache::HashValue(Ar, Path.MaxPlatforms);
+	ParkourGenerationCache::HashValue(Ar, Path.bAllowPlatformVariation);
+	ParkourGenerationCache::HashValue(Ar, Path.PlatformSizeVariation);
+	ParkourGenerationCache::HashValue(Ar, Path.RandomSeed);
+	ParkourGenerationCache::HashValue(Ar, (uint8)Path.PlacementMode);
+	if (Path.PlacementMode == EParkourPlacementMode::Optimal)
+	{
+		ParkourGenerationCache::HashValue(Ar, Path.OptimizerSampleSpacing);
+		ParkourGenerationCache::HashValue(Ar, Path.OptimizerEvenness);
+		ParkourGenerationCache::HashValue(Ar, Path.OptimizerTargetDifficulty);
+	}
+
+	// Rooftop snapping depends on the buildings of the source area
+	const bool bRooftops = Path.bUseBuildingRooftops && Path.RooftopSourceArea;
+	ParkourGenerationCache::HashValue(Ar, bRooftops);
+	if (bRooftops)
+	{
+		ParkourGenerationCache::HashValue(Ar, Path.RooftopSearchRadius);
+		ParkourGenerationCache::HashValue(Ar, Path.RooftopSourceArea->GeneratedBuildingBoxes);
+	}
+}
+
+FString FParkourGenerationCache::MakeKey(const TCHAR* Kind, const TArray<uint8>& Inputs)
+{
+	const FString Hash = FSHA1::HashBuffer(Inputs.GetData(), Inputs.Num()).ToString();
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("PARKOURGEN"), ParkourGenerationCache::Version, *FString::Printf(TEXT("%s_%s"), Kind, *Hash));
+}
+
+FString FParkourGenerationCache::MakePathKey(const AParkourPath& Path)
+{
+	if (!ParkourGenerationCache::IsEnabled() || Path.RandomSeed == 0)
+	{
+		return FString();
+	}
+
+	TArray<uint8> Inputs;
+	FMemoryWriter Ar(Inputs);
+	HashPathInputs(Ar, Path);
+
+	return MakeKey(TEXT("PATH"), Inputs);
+}
+
+FString FParkourGenerationCache::MakeEnvironmentKey(const AParkourPlayArea& PlayArea)
+{
+	if (!ParkourGenerationCache::IsEnabled() || PlayArea.EnvironmentSeed == 0)
+	{
+		return FString();
+	}
+
+	TArray<uint8> Inputs;
+	FMemoryWriter Ar(Inputs);
+
+	ParkourGenerationCache::HashValue(Ar, PlayArea.GetActorTransform());
+	ParkourGenerationCache::HashValue(Ar, (uint8)PlayArea.AreaShape);
+	ParkourGenerationCache::HashValue(Ar, PlayArea.AreaDimensions);
+	ParkourGenerationCache::HashValue(Ar, PlayArea.LShapeArmWidth);
+	ParkourGenerationCache::HashValue(Ar, PlayArea.UShapeArmWidth);
+	HashSpline(Ar, PlayArea.CustomBoundsSpline);
+
+	ParkourGenerationCache::HashValue(Ar, (uint8)PlayArea.EnvironmentStyle);
+	ParkourGenerationCache::HashValue(Ar, PlayArea.PathClearance);
+	ParkourGenerationCache::HashValue(Ar, PlayArea.BuildingDensity);
+	ParkourGenerationCache::HashValue(Ar, PlayArea.MinBuildingSize);
+	ParkourGenerationCache::HashValue(Ar, PlayArea.MaxBuildingSize);
+	ParkourGenerationCache::HashValue(Ar, PlayArea.EnvironmentSeed);
+
+	// Placement keeps clear of the path and its platforms
+	const AParkourPath* Path = PlayArea.ParkourPath;
+	ParkourGenerationCache::HashValue(Ar, Path != nullptr);
+	if (Path)
+	{
+		HashSpline(Ar, Path->PathSpline);
+
+		// A path built on this area's rooftops is solved after it, its platforms are not an input
+		const bool bRooftops = Path->IsUsingRooftopsOf(&PlayArea);
+		ParkourGenerationCache::HashValue(Ar, bRooftops);
+		if (!bRooftops)
+		{
+			ParkourGenerationCache::HashValue(Ar, Path->GeneratedPlatformTransforms);
+		}
+	}
+
+	return MakeKey(TEXT("ENV"), Inputs);
+}
+
+bool FParkourGenerationCache::GetPlatforms(const FString& Key, TArray<FTransform>& OutTransforms, TArray<bool>& OutOnRooftop)
+{
+	TArray<uint8> Data;
+	if (Key.IsEmpty() || !GetDerivedDataCacheRef().GetSynchronous(*Key, Data, ParkourGenerationCache::DataContext))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	Reader << OutTransforms;
+	Reader << OutOnRooftop;
+	return !Reader.IsError() && OutOnRooftop.Num() == OutTransforms.Num();
+}
+
+void FParkourGenerationCache::PutPlatforms(const FString& Key, const TArray<FTransform>& Transforms, const TArray<bool>& OnRooftop)
+{
+	if (Key.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	Writer << const_cast<TArray<FTransform>&>(Transforms);
+	Writer << const_cast<TArray<bool>&>(OnRooftop);
+	GetDerivedDataCacheRef().Put(*Key, Data, ParkourGenerationCache::DataContext);
+}
+
+bool FParkourGenerationCache::GetBuildings(const FString& Key, TArray<FBox>& OutBoxes)
+{
+	TArray<uint8> Data;
+	if (Key.IsEmpty() || !GetDerivedDataCacheRef().GetSynchronous(*Key, Data, ParkourGenerationCache::DataContext))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	Reader << OutBoxes;
+	return !Reader.IsError();
+}
+
+void FParkourGenerationCache::PutBuildings(const FString& Key, const TArray<FBox>& Boxes)
+{
+	if (Key.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	Writer << const_cast<TArray<FBox>&>(Boxes);
+	GetDerivedDataCacheRef().Put(*Key, Data, ParkourGenerationCache::DataContext);
+}
+
+#endif // WITH_EDITOR
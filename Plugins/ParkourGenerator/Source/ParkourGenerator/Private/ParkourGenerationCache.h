@@ -0,0 +1,41 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+class AParkourPath;
+class AParkourPlayArea;
+class USplineComponent;
+
+/**
+ * Content-addressed cache of generation results in the Derived Data Cache.
+ *
+ * Keys are hashes of everything a solve depends on (spline points, jump/platform parameters,
+ * area shape, seed), so a shared DDC lets the whole team skip solving unchanged actors.
+ * Only layouts with a fixed seed are cached, a seed of 0 asks for a new layout every time.
+ */
+class FParkourGenerationCache
+{
+public:
+	/** Key for the platform solve of a path, empty if the path cannot be cached */
+	static FString MakePathKey(const AParkourPath& Path);
+
+	/** Key for the environment solve of a play area, empty if the area cannot be cached */
+	static FString MakeEnvironmentKey(const AParkourPlayArea& PlayArea);
+
+	static bool GetPlatforms(const FString& Key, TArray<FTransform>& OutTransforms, TArray<bool>& OutOnRooftop);
+	static void PutPlatforms(const FString& Key, const TArray<FTransform>& Transforms, const TArray<bool>& OnRooftop);
+
+	static bool GetBuildings(const FString& Key, TArray<FBox>& OutBoxes);
+	static void PutBuildings(const FString& Key, const TArray<FBox>& Boxes);
+
+private:
+	static void HashSpline(FArchive& Ar, const USplineComponent* Spline);
+	static void HashPathInputs(FArchive& Ar, const AParkourPath& Path);
+	static FString MakeKey(const TCHAR* Kind, const TArray<uint8>& Inputs);
+};
+
+#endif // WITH_EDITOR
@@ -0,0 +1,138 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourGenerationReport.h"
+#include "ProceduralMeshComponent.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+void FParkourGenerationReport::AddSolveStats(const FParkourSolveStats& Stats)
+{
+	SplineSamples += Stats.SplineSamples;
+	RejectedJumps += Stats.RejectedJumps;
+	RejectedDensity += Stats.RejectedDensity;
+	RejectedOutsideArea += Stats.RejectedOutsideArea;
+	RejectedPathClearance += Stats.RejectedPathClearance;
+	RejectedPlatformClearance += Stats.RejectedPlatformClearance;
+}
+
+void FParkourGenerationReport::AddMeshes(const TArray<UProceduralMeshComponent*>& Meshes)
+{
+	for (UProceduralMeshComponent* Mesh : Meshes)
+	{
+		if (!Mesh)
+		{
+			continue;
+		}
+
+		Components++;
+		for (int32 Section = 0; Section < Mesh->GetNumSections(); Section++)
+		{
+			Triangles += Mesh->GetProcMeshSection(Section)->ProcIndexBuffer.Num() / 3;
+		}
+	}
+}
+
+void FParkourGenerationReport::Accumulate(const FParkourGenerationReport& Other)
+{
+	CacheHits += Other.CacheHits;
+	SolveTimeMs += Other.SolveTimeMs;
+	MeshTimeMs += Other.MeshTimeMs;
+	SplineSamples += Other.SplineSamples;
+	RejectedJumps += Other.RejectedJumps;
+	RejectedDensity += Other.RejectedDensity;
+	RejectedOutsideArea += Other.RejectedOutsideArea;
+	RejectedPathClearance += Other.RejectedPathClearance;
+	RejectedPlatformClearance += Other.RejectedPlatformClearance;
+	Platforms += Other.Platforms;
+	Buildings += Other.Buildings;
+	Components += Other.Components;
+	Triangles += Other.Triangles;
+}
+
+double FParkourGenerationReport::Start()
+{
+	StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	return FPlatformTime::Seconds();
+}
+
+void FParkourGenerationReport::Finish(double StartTime)
+{
+	TotalTimeMs = MillisecondsSince(StartTime);
+	MemoryDeltaMB = ((int64)FPlatformMemory::GetStats().UsedPhysical - (int64)StartUsedPhysical) / (1024.0f * 1024.0f);
+	Timestamp = FDateTime::UtcNow().ToIso8601();
+}
+
+FString FParkourGenerationReport::ToJson() const
+{
+	FString Json;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("name"), Name);
+	Writer->WriteValue(TEXT("map"), Map);
+	Writer->WriteValue(TEXT("timestamp"), Timestamp);
+	Writer->WriteValue(TEXT("seed"), Seed);
+	Writer->WriteValue(TEXT("cacheHits"), CacheHits);
+	Writer->WriteValue(TEXT("solveTimeMs"), SolveTimeMs);
+	Writer->WriteValue(TEXT("meshTimeMs"), MeshTimeMs);
+	Writer->WriteValue(TEXT("totalTimeMs"), TotalTimeMs);
+	Writer->WriteValue(TEXT("splineSamples"), SplineSamples);
+	Writer->WriteValue(TEXT("rejectedJumps"), RejectedJumps);
+	Writer->WriteValue(TEXT("rejectedDensity"), RejectedDensity);
+	Writer->WriteValue(TEXT("rejectedOutsideArea"), RejectedOutsideArea);
+	Writer->WriteValue(TEXT("rejectedPathClearance"), RejectedPathClearance);
+	Writer->WriteValue(TEXT("rejectedPlatformClearance"), RejectedPlatformClearance);
+	Writer->WriteValue(TEXT("platforms"), Platforms);
+	Writer->WriteValue(TEXT("buildings"), Buildings);
+	Writer->WriteValue(TEXT("components"), Components);
+	Writer->WriteValue(TEXT("triangles"), Triangles);
+	Writer->WriteValue(TEXT("memoryDeltaMB"), MemoryDeltaMB);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Json;
+}
+
+FString FParkourGenerationReport::GetCsvHeader()
+{
+	return TEXT("Name,Map,Timestamp,Seed,CacheHits,SolveTimeMs,MeshTimeMs,TotalTimeMs,SplineSamples,RejectedJumps,RejectedDensity,")
+		TEXT("RejectedOutsideArea,RejectedPathClearance,RejectedPlatformClearance,Platforms,Buildings,Components,Triangles,MemoryDeltaMB");
+}
+
+FString FParkourGenerationReport::ToCsvRow() const
+{
+	auto Quote = [](const FString& Value)
+	{
+		return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+	};
+
+	return FString::Printf(TEXT("%s,%s,%s,%d,%d,%.3f,%.3f,%.3f,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.1f"),
+		*Quote(Name), *Quote(Map), *Quote(Timestamp), Seed, CacheHits, SolveTimeMs, MeshTimeMs, TotalTimeMs,
+		SplineSamples, RejectedJumps, RejectedDensity, RejectedOutsideArea, RejectedPathClearance, RejectedPlatformClearance,
+		Platforms, Buildings, Components, Triangles, MemoryDeltaMB);
+}
+
+bool FParkourGenerationReport::AppendToFile(const FString& FilePath) const
+{
+	const FString FullPath = FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectDir(), FilePath) : FilePath;
+	const bool bCsv = FPaths::GetExtension(FullPath).Equals(TEXT("csv"), ESearchCase::IgnoreCase);
+
+	FString Lines;
+	if (bCsv && IFileManager::Get().FileSize(*FullPath) <= 0)
+	{
+		Lines = GetCsvHeader() + LINE_TERMINATOR;
+	}
+	Lines += (bCsv ? ToCsvRow() : ToJson()) + LINE_TERMINATOR;
+
+	if (!FFileHelper::SaveStringToFile(Lines, *FullPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Failed to append generation report to %s"), *FullPath);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,272 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourJumpGraph.h"
+#include "ParkourPath.h"
+#include "ParkourLLM.h"
+#include "Algo/Reverse.h"
+
+namespace ParkourJumpGraph
+{
+	/** Cost multiplier applied to the jumps of an already found route when looking for alternates */
+	static constexpr float AlternateRoutePenalty = 3.0f;
+
+	/** Base cost of every jump on the safest route, so it does not take arbitrarily many tiny hops */
+	static constexpr float SafeJumpBaseCost = 0.1f;
+
+	struct FOpenNode
+	{
+		int32 Node;
+		float Priority;
+	};
+
+	struct FOpenNodeLess
+	{
+		bool operator()(const FOpenNode& A, const FOpenNode& B) const
+		{
+			return A.Priority < B.Priority;
+		}
+	};
+}
+
+void FParkourJumpGraph::Build(const AParkourPath& Path, const TArray<FTransform>& Platforms)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_PathSolve);
+
+	const int32 NumPlatforms = Platforms.Num();
+
+	Positions.Reset(NumPlatforms);
+	for (const FTransform& Platform : Platforms)
+	{
+		Positions.Add(Platform.GetLocation());
+	}
+
+	// Uniform grid with cells as large as the jump reach (long drops included): every reachable platform is in the 3x3 neighbourhood
+	const float CellSize = FMath::Max(Path.GetMaxJumpReach(), 1.0f);
+	auto GetCell = [CellSize](const FVector& Position)
+	{
+		return FIntPoint(FMath::FloorToInt(Position.X / CellSize), FMath::FloorToInt(Position.Y / CellSize));
+	};
+
+	TMap<FIntPoint, TArray<int32>> Grid;
+	Grid.Reserve(NumPlatforms);
+	for (int32 i = 0; i < NumPlatforms; i++)
+	{
+		Grid.FindOrAdd(GetCell(Positions[i])).Add(i);
+	}
+
+	EdgeOffsets.SetNumUninitialized(NumPlatforms + 1);
+	Edges.Reset();
+
+	for (int32 i = 0; i < NumPlatforms; i++)
+	{
+		EdgeOffsets[i] = Edges.Num();
+
+		const FVector& From = Positions[i];
+		const FIntPoint Cell = GetCell(From);
+
+		for (int32 DX = -1; DX <= 1; DX++)
+		{
+			for (int32 DY = -1; DY <= 1; DY++)
+			{
+				const TArray<int32>* Candidates = Grid.Find(Cell + FIntPoint(DX, DY));
+				if (!Candidates)
+				{
+					continue;
+				}
+
+				for (int32 j : *Candidates)
+				{
+					const FVector& To = Positions[j];
+					if (j == i || !Path.IsJumpValid(From, To))
+					{
+						continue;
+					}
+
+					FEdge& Edge = Edges.AddDefaulted_GetRef();
+					Edge.To = j;
+					Edge.Distance = FVector::Dist(From, To);
+					Edge.Difficulty = Path.GetJumpDifficulty(From, To);
+				}
+			}
+		}
+	}
+
+	EdgeOffsets[NumPlatforms] = Edges.Num();
+}
+
+float FParkourJumpGraph::GetEdgeCost(const FEdge& Edge, EParkourRouteMetric Metric) const
+{
+	if (Metric == EParkourRouteMetric::Safest)
+	{
+		return ParkourJumpGraph::SafeJumpBaseCost + FMath::Square(Edge.Difficulty);
+	}
+
+	return Edge.Distance;
+}
+
+bool FParkourJumpGraph::FindRoute(int32 Start, int32 Goal, EParkourRouteMetric Metric, FParkourRoute& OutRoute) const
+{
+	return FindRouteInternal(Start, Goal, Metric, nullptr, OutRoute);
+}
+
+bool FParkourJumpGraph::FindRouteInternal(int32 Start, int32 Goal, EParkourRouteMetric Metric, const TArray<float>* EdgePenalties, FParkourRoute& OutRoute) const
+{
+	OutRoute = FParkourRoute();
+
+	const int32 NumPlatforms = NumNodes();
+	if (!Positions.IsValidIndex(Start) || !Positions.IsValidIndex(Goal))
+	{
+		return false;
+	}
+
+	// Straight-line distance never overestimates a distance cost (A*), the safest metric has no useful bound (Dijkstra)
+	const FVector GoalPosition = Positions[Goal];
+	auto Heuristic = [this, &GoalPosition, Metric](int32 Node)
+	{
+		return Metric == EParkourRouteMetric::Shortest ? (float)FVector::Dist(Positions[Node], GoalPosition) : 0.0f;
+	};
+
+	TArray<float> Cost;
+	Cost.Init(MAX_flt, NumPlatforms);
+	TArray<int32> ParentEdge;
+	ParentEdge.Init(INDEX_NONE, NumPlatforms);
+	TArray<int32> Parent;
+	Parent.Init(INDEX_NONE, NumPlatforms);
+	TBitArray<> Closed(false, NumPlatforms);
+
+	TArray<ParkourJumpGraph::FOpenNode> Open;
+	const ParkourJumpGraph::FOpenNodeLess Less;
+
+	Cost[Start] = 0.0f;
+	Open.HeapPush({Start, Heuristic(Start)}, Less);
+
+	while (Open.Num() > 0)
+	{
+		ParkourJumpGraph::FOpenNode Current;
+		Open.HeapPop(Current, Less);
+
+		if (Closed[Current.Node])
+		{
+			continue;
+		}
+		Closed[Current.Node] = true;
+
+		if (Current.Node == Goal)
+		{
+			break;
+		}
+
+		for (int32 EdgeIndex = EdgeOffsets[Current.Node]; EdgeIndex < EdgeOffsets[Current.Node + 1]; EdgeIndex++)
+		{
+			const FEdge& Edge = Edges[EdgeIndex];
+			if (Closed[Edge.To])
+			{
+				continue;
+			}
+
+			float EdgeCost = GetEdgeCost(Edge, Metric);
+			if (EdgePenalties)
+			{
+				EdgeCost *= (*EdgePenalties)[EdgeIndex];
+			}
+
+			const float NewCost = Cost[Current.Node] + EdgeCost;
+			if (NewCost < Cost[Edge.To])
+			{
+				Cost[Edge.To] = NewCost;
+				Parent[Edge.To] = Current.Node;
+				ParentEdge[Edge.To] = EdgeIndex;
+				Open.HeapPush({Edge.To, NewCost + Heuristic(Edge.To)}, Less);
+			}
+		}
+	}
+
+	if (!Closed[Goal])
+	{
+		return false;
+	}
+
+	for (int32 Node = Goal; Node != INDEX_NONE; Node = Parent[Node])
+	{
+		OutRoute.PlatformIndices.Add(Node);
+
+		if (ParentEdge[Node] != INDEX_NONE)
+		{
+			const FEdge& Edge = Edges[ParentEdge[Node]];
+			OutRoute.Length += Edge.Distance;
+			OutRoute.Risk += FMath::Square(Edge.Difficulty);
+		}
+	}
+	Algo::Reverse(OutRoute.PlatformIndices);
+
+	return true;
+}
+
+void FParkourJumpGraph::FindAlternateRoutes(int32 Start, int32 Goal, int32 MaxRoutes, TArray<FParkourRoute>& OutRoutes) const
+{
+	OutRoutes.Reset();
+
+	TArray<float> EdgePenalties;
+	EdgePenalties.Init(1.0f, Edges.Num());
+
+	// Penalizing used jumps converges on the same route when there is no alternative, so bound the attempts
+	const int32 MaxAttempts = MaxRoutes * 2;
+	for (int32 Attempt = 0; Attempt < MaxAttempts && OutRoutes.Num() < MaxRoutes; Attempt++)
+	{
+		FParkourRoute Route;
+		if (!FindRouteInternal(Start, Goal, EParkourRouteMetric::Shortest, &EdgePenalties, Route))
+		{
+			break;
+		}
+
+		// Penalize every jump of this route so the next search prefers other ones
+		for (int32 i = 0; i < Route.PlatformIndices.Num() - 1; i++)
+		{
+			const int32 From = Route.PlatformIndices[i];
+			const int32 To = Route.PlatformIndices[i + 1];
+			for (int32 EdgeIndex = EdgeOffsets[From]; EdgeIndex < EdgeOffsets[From + 1]; EdgeIndex++)
+			{
+				if (Edges[EdgeIndex].To == To)
+				{
+					EdgePenalties[EdgeIndex] *= ParkourJumpGraph::AlternateRoutePenalty;
+					break;
+				}
+			}
+		}
+
+		const bool bDuplicate = OutRoutes.ContainsByPredicate([&Route](const FParkourRoute& Existing)
+		{
+			return Existing.PlatformIndices == Route.PlatformIndices;
+		});
+
+		if (!bDuplicate)
+		{
+			OutRoutes.Add(MoveTemp(Route));
+		}
+	}
+}
+
+void FParkourJumpGraph::FindShortcuts(int32 MinSkipped, TArray<FParkourShortcut>& OutShortcuts) const
+{
+	OutShortcuts.Reset();
+
+	for (int32 From = 0; From < NumNodes(); From++)
+	{
+		int32 FarthestTo = INDEX_NONE;
+		for (const FEdge& Edge : GetEdges(From))
+		{
+			if (Edge.To - From - 1 >= FMath::Max(MinSkipped, 1) && Edge.To > FarthestTo)
+			{
+				FarthestTo = Edge.To;
+			}
+		}
+
+		if (FarthestTo != INDEX_NONE)
+		{
+			FParkourShortcut& Shortcut = OutShortcuts.AddDefaulted_GetRef();
+			Shortcut.FromIndex = From;
+			Shortcut.ToIndex = FarthestTo;
+			Shortcut.SkippedPlatforms = FarthestTo - From - 1;
+		}
+	}
+}
@@ -0,0 +1,85 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourJumpValidation.h"
+#include "ParkourPath.h"
+#include "ParkourReachabilityTable.h"
+
+uint32 FParkourJumpValidation::GetParameterHash(const AParkourPath& Path)
+{
+	const bool bReachabilityTable = Path.UsesReachabilityTable();
+	const FVector4 Parameters(Path.GetSafeJumpDistance(), Path.GetSafeJumpHeight(), Path.JumpSafetyMargin, bReachabilityTable ? 1.0f : 0.0f);
+	const uint32 Hash = FCrc::MemCrc32(&Parameters, sizeof(FVector4));
+	return bReachabilityTable ? HashCombine(Hash, Path.ReachabilityTable->GetTableHash()) : Hash;
+}
+
+void FParkourJumpValidation::Reset()
+{
+	Locations.Reset();
+	ValidJumps.Empty();
+	InvalidJumps.Reset();
+}
+
+int32 FParkourJumpValidation::Update(const AParkourPath& Path, const TArray<FTransform>& Platforms)
+{
+	const uint32 NewParameterHash = GetParameterHash(Path);
+	if (NewParameterHash != ParameterHash)
+	{
+		Reset();
+		ParameterHash = NewParameterHash;
+	}
+
+	const int32 OldNum = Locations.Num();
+	const int32 NewNum = Platforms.Num();
+	const int32 MaxMatching = FMath::Min(OldNum, NewNum);
+
+	// Platforms that did not move, from the start and from the end
+	int32 Prefix = 0;
+	while (Prefix < MaxMatching && Locations[Prefix] == Platforms[Prefix].GetLocation())
+	{
+		Prefix++;
+	}
+
+	int32 Suffix = 0;
+	while (Suffix < MaxMatching - Prefix && Locations[OldNum - 1 - Suffix] == Platforms[NewNum - 1 - Suffix].GetLocation())
+	{
+		Suffix++;
+	}
+
+	// Jumps with both ends in the prefix or both in the suffix keep their result
+	const int32 NumJumps = FMath::Max(NewNum - 1, 0);
+	const int32 FirstDirty = FMath::Max(Prefix - 1, 0);
+	const int32 EndDirty = FMath::Min(NewNum - Suffix, NumJumps);
+
+	TBitArray<> NewValidJumps(false, NumJumps);
+	for (int32 Jump = 0; Jump < FMath::Min(FirstDirty, NumJumps); Jump++)
+	{
+		NewValidJumps[Jump] = ValidJumps[Jump];
+	}
+	for (int32 Jump = EndDirty; Jump < NumJumps; Jump++)
+	{
+		NewValidJumps[Jump] = ValidJumps[Jump - NewNum + OldNum];
+	}
+	for (int32 Jump = FirstDirty; Jump < EndDirty; Jump++)
+	{
+		NewValidJumps[Jump] = Path.IsJumpValid(Platforms[Jump].GetLocation(), Platforms[Jump + 1].GetLocation());
+	}
+
+	ValidJumps = MoveTemp(NewValidJumps);
+
+	Locations.SetNumUninitialized(NewNum);
+	for (int32 i = FMath::Min(Prefix, NewNum); i < NewNum; i++)
+	{
+		Locations[i] = Platforms[i].GetLocation();
+	}
+
+	InvalidJumps.Reset();
+	for (int32 Jump = 0; Jump < NumJumps; Jump++)
+	{
+		if (!ValidJumps[Jump])
+		{
+			InvalidJumps.Add(Jump);
+		}
+	}
+
+	return FMath::Max(EndDirty - FirstDirty, 0);
+}
@@ -0,0 +1,28 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourLLM.h"
+#include "ProceduralMeshComponent.h"
+
+LLM_DEFINE_TAG(ParkourGenerator);
+LLM_DEFINE_TAG(ParkourGenerator_PathSolve);
+LLM_DEFINE_TAG(ParkourGenerator_Environment);
+LLM_DEFINE_TAG(ParkourGenerator_MeshData);
+LLM_DEFINE_TAG(ParkourGenerator_Collision);
+LLM_DEFINE_TAG(ParkourGenerator_Preview);
+
+void ParkourLLM::CreateMeshSection(UProceduralMeshComponent& Mesh, int32 SectionIndex, const TArray<FVector>& Vertices, const TArray<int32>& Triangles,
+	const TArray<FVector>& Normals, const TArray<FVector2D>& UVs, const TArray<FColor>& VertexColors)
+{
+	FProcMeshSection Section;
+	{
+		LLM_SCOPE_BYTAG(ParkourGenerator_MeshData);
+		Mesh.CreateMeshSection(SectionIndex, Vertices, Triangles, Normals, UVs, VertexColors, TArray<FProcMeshTangent>(), false);
+
+		Section = *Mesh.GetProcMeshSection(SectionIndex);
+		Section.bEnableCollision = true;
+	}
+
+	// Setting the built section again with collision enabled cooks its body setup, convex collision is kept
+	LLM_SCOPE_BYTAG(ParkourGenerator_Collision);
+	Mesh.SetProcMeshSection(SectionIndex, Section);
+}
@@ -0,0 +1,39 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+class UProceduralMeshComponent;
+
+/**
+ * Low Level Memory tracker tags of the generator. Each is a child of ParkourGenerator, so -llm captures,
+ * stat LLM and memreport show what the blockout costs in total and per part. Compiled out without LLM.
+ */
+LLM_DECLARE_TAG(ParkourGenerator);
+
+/** Platform solves, generated platform transforms and layouts, path BVHs and jump graphs */
+LLM_DECLARE_TAG(ParkourGenerator_PathSolve);
+
+/** Building solves, generated building boxes and layouts */
+LLM_DECLARE_TAG(ParkourGenerator_Environment);
+
+/** Procedural mesh components and their section arrays, baked mesh descriptions */
+LLM_DECLARE_TAG(ParkourGenerator_MeshData);
+
+/** Body setups and cooked collision of the generated meshes */
+LLM_DECLARE_TAG(ParkourGenerator_Collision);
+
+/** Editor preview lines, labels and their scene proxies */
+LLM_DECLARE_TAG(ParkourGenerator_Preview);
+
+namespace ParkourLLM
+{
+	/**
+	 * Create a mesh section with collision, the section arrays tracked as MeshData and the body setup as
+	 * Collision (the component creates both in one call otherwise)
+	 */
+	void CreateMeshSection(UProceduralMeshComponent& Mesh, int32 SectionIndex, const TArray<FVector>& Vertices, const TArray<int32>& Triangles,
+		const TArray<FVector>& Normals, const TArray<FVector2D>& UVs, const TArray<FColor>& VertexColors);
+}
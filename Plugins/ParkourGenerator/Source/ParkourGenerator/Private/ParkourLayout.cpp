@@ -0,0 +1,208 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourLayout.h"
+#include "Hash/CityHash.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace ParkourLayout
+{
+	/** Centimeters to the 1 mm storage grid */
+	static FIntVector QuantizeVector(const FVector& Value)
+	{
+		return FIntVector(
+			FMath::RoundToInt(Value.X * 10.0f),
+			FMath::RoundToInt(Value.Y * 10.0f),
+			FMath::RoundToInt(Value.Z * 10.0f)
+		);
+	}
+
+	static FVector DequantizeVector(const FIntVector& Value)
+	{
+		return FVector(Value.X, Value.Y, Value.Z) * 0.1f;
+	}
+}
+
+FParkourPlatformRecord FParkourPlatformRecord::FromTransform(const FTransform& Transform)
+{
+	FParkourPlatformRecord Record;
+	Record.Location = ParkourLayout::QuantizeVector(Transform.GetLocation());
+
+	// Platform rotations come from path directions, so they never carry roll
+	const FRotator Rotation = Transform.GetRotation().Rotator();
+	Record.Pitch = FRotator::CompressAxisToShort(Rotation.Pitch);
+	Record.Yaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+	Record.Scale = (uint16)FMath::Clamp(FMath::RoundToInt(Transform.GetScale3D().X * 1000.0f), 0, (int32)MAX_uint16);
+	return Record;
+}
+
+FTransform FParkourPlatformRecord::ToTransform() const
+{
+	const FRotator Rotation(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw), 0.0f);
+	const float XYScale = Scale / 1000.0f;
+	return FTransform(Rotation, ParkourLayout::DequantizeVector(Location), FVector(XYScale, XYScale, 1.0f));
+}
+
+FParkourBuildingRecord FParkourBuildingRecord::FromBox(const FBox& Box)
+{
+	FParkourBuildingRecord Record;
+	const FVector Center = Box.GetCenter();
+	Record.Location = ParkourLayout::QuantizeVector(FVector(Center.X, Center.Y, Box.Min.Z));
+	Record.Size = ParkourLayout::QuantizeVector(Box.GetSize());
+	return Record;
+}
+
+FBox FParkourBuildingRecord::ToBox() const
+{
+	const FVector BottomCenter = ParkourLayout::DequantizeVector(Location);
+	const FVector BoxSize = ParkourLayout::DequantizeVector(Size);
+	return FBox(
+		BottomCenter - FVector(BoxSize.X * 0.5f, BoxSize.Y * 0.5f, 0),
+		BottomCenter + FVector(BoxSize.X * 0.5f, BoxSize.Y * 0.5f, BoxSize.Z)
+	);
+}
+
+void FParkourCompactLayout::Reset()
+{
+	Seed = 0;
+	Platforms.Empty();
+	ExactPlatforms.Empty();
+	RooftopPlatforms.Empty();
+	Buildings.Empty();
+	ExactBuildings.Empty();
+	bFloor = false;
+}
+
+void FParkourCompactLayout::SetPlatforms(const TArray<FTransform>& Transforms, bool bQuantize)
+{
+	Platforms.Reset();
+	ExactPlatforms.Reset();
+	if (!bQuantize)
+	{
+		ExactPlatforms = Transforms;
+		return;
+	}
+
+	Platforms.Reserve(Transforms.Num());
+	for (const FTransform& Transform : Transforms)
+	{
+		Platforms.Add(FParkourPlatformRecord::FromTransform(Transform));
+	}
+}
+
+void FParkourCompactLayout::GetPlatforms(TArray<FTransform>& OutTransforms) const
+{
+	if (ExactPlatforms.Num() > 0)
+	{
+		OutTransforms = ExactPlatforms;
+		return;
+	}
+
+	OutTransforms.Reset(Platforms.Num());
+	for (const FParkourPlatformRecord& Record : Platforms)
+	{
+		OutTransforms.Add(Record.ToTransform());
+	}
+}
+
+void FParkourCompactLayout::SetRooftopPlatforms(const TArray<bool>& OnRooftop)
+{
+	RooftopPlatforms.Reset();
+	for (int32 i = 0; i < OnRooftop.Num(); i++)
+	{
+		if (OnRooftop[i])
+		{
+			RooftopPlatforms.Add(i);
+		}
+	}
+}
+
+void FParkourCompactLayout::GetRooftopPlatforms(TArray<bool>& OutOnRooftop) const
+{
+	OutOnRooftop.Init(false, Platforms.Num() + ExactPlatforms.Num());
+	for (int32 Index : RooftopPlatforms)
+	{
+		if (OutOnRooftop.IsValidIndex(Index))
+		{
+			OutOnRooftop[Index] = true;
+		}
+	}
+}
+
+void FParkourCompactLayout::SetBuildings(const TArray<FBox>& Boxes, bool bQuantize)
+{
+	Buildings.Reset();
+	ExactBuildings.Reset();
+	if (!bQuantize)
+	{
+		ExactBuildings = Boxes;
+		return;
+	}
+
+	Buildings.Reserve(Boxes.Num());
+	for (const FBox& Box : Boxes)
+	{
+		Buildings.Add(FParkourBuildingRecord::FromBox(Box));
+	}
+}
+
+void FParkourCompactLayout::GetBuildings(TArray<FBox>& OutBoxes) const
+{
+	if (ExactBuildings.Num() > 0)
+	{
+		OutBoxes = ExactBuildings;
+		return;
+	}
+
+	OutBoxes.Reset(Buildings.Num());
+	for (const FParkourBuildingRecord& Record : Buildings)
+	{
+		OutBoxes.Add(Record.ToBox());
+	}
+}
+
+uint64 FParkourCompactLayout::GetFingerprint() const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+
+	// Full precision layouts hash as they would be saved quantized
+	TArray<FParkourPlatformRecord> PlatformRecords = Platforms;
+	for (const FTransform& Transform : ExactPlatforms)
+	{
+		PlatformRecords.Add(FParkourPlatformRecord::FromTransform(Transform));
+	}
+	TArray<FParkourBuildingRecord> BuildingRecords = Buildings;
+	for (const FBox& Box : ExactBuildings)
+	{
+		BuildingRecords.Add(FParkourBuildingRecord::FromBox(Box));
+	}
+
+	// Field by field, so padding never ends up in the hash
+	int32 NumPlatforms = PlatformRecords.Num();
+	Ar << NumPlatforms;
+	for (FParkourPlatformRecord Record : PlatformRecords)
+	{
+		Ar << Record.Location << Record.Pitch << Record.Yaw << Record.Scale;
+	}
+
+	TArray<int32> Rooftops = RooftopPlatforms;
+	Ar << Rooftops;
+
+	int32 NumBuildings = BuildingRecords.Num();
+	Ar << NumBuildings;
+	for (FParkourBuildingRecord Record : BuildingRecords)
+	{
+		Ar << Record.Location << Record.Size;
+	}
+
+	return CityHash64((const char*)Bytes.GetData(), Bytes.Num());
+}
+
+uint64 FParkourCompactLayout::MakeFingerprint(const TArray<FTransform>& Platforms, const TArray<bool>& OnRooftop, const TArray<FBox>& Buildings)
+{
+	FParkourCompactLayout Layout;
+	Layout.SetPlatforms(Platforms);
+	Layout.SetRooftopPlatforms(OnRooftop);
+	Layout.SetBuildings(Buildings);
+	return Layout.GetFingerprint();
+}
@@ -0,0 +1,99 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourLayoutFile.h"
+
+bool FParkourLayoutView::IsSectionValid(const FParkourLayoutFileSection& Section, uint32 MinStride, int64 DataSize)
+{
+	if (Section.Count == 0)
+	{
+		return true;
+	}
+
+	if (Section.Stride < MinStride || Section.Offset % ParkourLayoutFile::SectionAlignment != 0)
+	{
+		return false;
+	}
+
+	const uint64 SectionEnd = Section.Offset + (uint64)Section.Count * Section.Stride;
+	return SectionEnd <= (uint64)DataSize && SectionEnd > Section.Offset;
+}
+
+bool FParkourLayoutView::Initialize(const uint8* InData, int64 InSize)
+{
+	Data = nullptr;
+	Header = nullptr;
+
+	if (!InData || InSize < (int64)sizeof(FParkourLayoutFileHeader))
+	{
+		return false;
+	}
+
+	const FParkourLayoutFileHeader* FileHeader = reinterpret_cast<const FParkourLayoutFileHeader*>(InData);
+	if (FileHeader->Magic != ParkourLayoutFile::Magic
+		|| FileHeader->Version == 0
+		|| FileHeader->Version > ParkourLayoutFile::Version
+		|| FileHeader->HeaderSize < sizeof(FParkourLayoutFileHeader)
+		|| FileHeader->FileSize > (uint64)InSize)
+	{
+		return false;
+	}
+
+	if (!IsSectionValid(FileHeader->Platforms, sizeof(FParkourLayoutFilePlatform), InSize)
+		|| !IsSectionValid(FileHeader->Buildings, sizeof(FParkourLayoutFileBuilding), InSize)
+		|| !IsSectionValid(FileHeader->PathSamples, sizeof(FParkourLayoutFilePathSample), InSize))
+	{
+		return false;
+	}
+
+	Data = InData;
+	Header = FileHeader;
+	return true;
+}
+
+void FParkourLayoutWriter::Write(
+	const FParkourLayoutFileParams& Params,
+	TArrayView<const FParkourLayoutFilePlatform> Platforms,
+	TArrayView<const FParkourLayoutFileBuilding> Buildings,
+	TArrayView<const FParkourLayoutFilePathSample> PathSamples,
+	TArray<uint8>& OutData)
+{
+	FParkourLayoutFileHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = ParkourLayoutFile::Magic;
+	Header.Version = ParkourLayoutFile::Version;
+	Header.HeaderSize = sizeof(FParkourLayoutFileHeader);
+	Header.Params = Params;
+
+	// Lay out the sections back to back, each aligned for in-place access
+	uint64 Offset = sizeof(FParkourLayoutFileHeader);
+	auto PlaceSection = [&Offset](FParkourLayoutFileSection& Section, int32 Count, uint32 Stride)
+	{
+		Offset = Align(Offset, (uint64)ParkourLayoutFile::SectionAlignment);
+		Section.Offset = Offset;
+		Section.Count = Count;
+		Section.Stride = Stride;
+		Offset += (uint64)Count * Stride;
+	};
+
+	PlaceSection(Header.Platforms, Platforms.Num(), sizeof(FParkourLayoutFilePlatform));
+	PlaceSection(Header.Buildings, Buildings.Num(), sizeof(FParkourLayoutFileBuilding));
+	PlaceSection(Header.PathSamples, PathSamples.Num(), sizeof(FParkourLayoutFilePathSample));
+	Header.FileSize = Align(Offset, (uint64)ParkourLayoutFile::SectionAlignment);
+
+	OutData.Reset();
+	OutData.SetNumZeroed(Header.FileSize);
+
+	FMemory::Memcpy(OutData.GetData(), &Header, sizeof(Header));
+	if (Platforms.Num() > 0)
+	{
+		FMemory::Memcpy(OutData.GetData() + Header.Platforms.Offset, Platforms.GetData(), Platforms.Num() * sizeof(FParkourLayoutFilePlatform));
+	}
+	if (Buildings.Num() > 0)
+	{
+		FMemory::Memcpy(OutData.GetData() + Header.Buildings.Offset, Buildings.GetData(), Buildings.Num() * sizeof(FParkourLayoutFileBuilding));
+	}
+	if (PathSamples.Num() > 0)
+	{
+		FMemory::Memcpy(OutData.GetData() + Header.PathSamples.Offset, PathSamples.GetData(), PathSamples.Num() * sizeof(FParkourLayoutFilePathSample));
+	}
+}
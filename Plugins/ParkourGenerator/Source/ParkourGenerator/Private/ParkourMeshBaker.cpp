@@ -0,0 +1,205 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourMeshBaker.h"
+
+#if WITH_EDITOR
+
+#include "ProceduralMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/Package.h"
+#include "Misc/PackageName.h"
+
+UStaticMesh* FParkourMeshBaker::BakeToStaticMesh(const TArray<UProceduralMeshComponent*>& Components, const FTransform& Pivot, const FString& PackagePath, const FString& AssetName)
+{
+	// The bake path is a free-form setting, e.g. a missing /Game/ root would not name a package
+	const FString PackageName = PackagePath / AssetName;
+	FText Reason;
+	if (!FPackageName::IsValidLongPackageName(PackageName, false, &Reason))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Cannot bake to %s, check BakedAssetPath in the plugin settings (%s)"), *PackageName, *Reason.ToString());
+		return nullptr;
+	}
+
+	FMeshDescription MeshDescription;
+	FStaticMeshAttributes Attributes(MeshDescription);
+	Attributes.Register();
+
+	TVertexAttributesRef<FVector3f> VertexPositions = Attributes.GetVertexPositions();
+	TVertexInstanceAttributesRef<FVector3f> InstanceNormals = Attributes.GetVertexInstanceNormals();
+	TVertexInstanceAttributesRef<FVector2f> InstanceUVs = Attributes.GetVertexInstanceUVs();
+	TVertexInstanceAttributesRef<FVector4f> InstanceColors = Attributes.GetVertexInstanceColors();
+	TPolygonGroupAttributesRef<FName> MaterialSlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+
+	// Blockout geometry uses a single material slot, so everything goes into one polygon group
+	const FName MaterialSlotName(TEXT("Blockout"));
+	const FPolygonGroupID PolygonGroup = MeshDescription.CreatePolygonGroup();
+	MaterialSlotNames[PolygonGroup] = MaterialSlotName;
+
+	TArray<FKBoxElem> CollisionBoxes;
+	TArray<FVertexInstanceID> SectionInstances;
+
+	for (UProceduralMeshComponent* Component : Components)
+	{
+		if (!Component)
+		{
+			continue;
+		}
+
+		// Component space -> pivot space
+		const FTransform RelativeTransform = Component->GetComponentTransform().GetRelativeTransform(Pivot);
+		FBox ComponentBox(ForceInit);
+
+		for (int32 SectionIndex = 0; SectionIndex < Component->GetNumSections(); SectionIndex++)
+		{
+			const FProcMeshSection* Section = Component->GetProcMeshSection(SectionIndex);
+			if (!Section || Section->ProcIndexBuffer.Num() < 3)
+			{
+				continue;
+			}
+
+			SectionInstances.Reset(Section->ProcVertexBuffer.Num());
+			for (const FProcMeshVertex& Vertex : Section->ProcVertexBuffer)
+			{
+				const FVertexID VertexID = MeshDescription.CreateVertex();
+				VertexPositions[VertexID] = FVector3f(RelativeTransform.TransformPosition(Vertex.Position));
+
+				const FVertexInstanceID InstanceID = MeshDescription.CreateVertexInstance(VertexID);
+				InstanceNormals[InstanceID] = FVector3f(RelativeTransform.TransformVectorNoScale(Vertex.Normal));
+				InstanceUVs.Set(InstanceID, 0, FVector2f(Vertex.UV0));
+				InstanceColors[InstanceID] = FVector4f(FLinearColor(Vertex.Color));
+				SectionInstances.Add(InstanceID);
+			}
+
+			for (int32 i = 0; i + 2 < Section->ProcIndexBuffer.Num(); i += 3)
+			{
+				const FVertexInstanceID TriangleInstances[3] = {
+					SectionInstances[Section->ProcIndexBuffer[i]],
+					SectionInstances[Section->ProcIndexBuffer[i + 1]],
+					SectionInstances[Section->ProcIndexBuffer[i + 2]]
+				};
+				MeshDescription.CreateTriangle(PolygonGroup, TriangleInstances);
+			}
+
+			ComponentBox += Section->SectionLocalBox;
+		}
+
+		if (!ComponentBox.IsValid)
+		{
+			continue;
+		}
+
+		// One box collision element per component (platforms, buildings and floors are all boxes)
+		const FVector BoxSize = ComponentBox.GetSize() * RelativeTransform.GetScale3D().GetAbs();
+		FKBoxElem CollisionBox(
+			FMath::Max(BoxSize.X, 1.0),
+			FMath::Max(BoxSize.Y, 1.0),
+			FMath::Max(BoxSize.Z, 1.0)
+		);
+		CollisionBox.Center = RelativeTransform.TransformPosition(ComponentBox.GetCenter());
+		CollisionBox.Rotation = RelativeTransform.GetRotation().Rotator();
+		CollisionBoxes.Add(CollisionBox);
+	}
+
+	if (MeshDescription.Triangles().Num() == 0)
+	{
+		return nullptr;
+	}
+
+	UPackage* Package = CreatePackage(*PackageName);
+	if (!Package)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Failed to create package %s"), *PackageName);
+		return nullptr;
+	}
+	Package->FullyLoad();
+
+	// Re-baking overwrites the previous asset instead of creating a new one every time
+	UStaticMesh* StaticMesh = FindObject<UStaticMesh>(Package, *AssetName);
+	const bool bNewAsset = (StaticMesh == nullptr);
+	if (!bNewAsset)
+	{
+		StaticMesh->Modify();
+	}
+	else
+	{
+		StaticMesh = NewObject<UStaticMesh>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+		StaticMesh->InitResources();
+		StaticMesh->SetLightingGuid();
+	}
+
+	if (StaticMesh->GetNumSourceModels() == 0)
+	{
+		StaticMesh->AddSourceModel();
+	}
+
+	FStaticMeshSourceModel& SourceModel = StaticMesh->GetSourceModel(0);
+	SourceModel.BuildSettings.bRecomputeNormals = false;
+	SourceModel.BuildSettings.bRecomputeTangents = true;
+	SourceModel.BuildSettings.bRemoveDegenerates = false;
+	SourceModel.BuildSettings.bGenerateLightmapUVs = true;
+
+	StaticMesh->GetStaticMaterials().Reset();
+	StaticMesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, MaterialSlotName, MaterialSlotName));
+
+	StaticMesh->CreateMeshDescription(0, MoveTemp(MeshDescription));
+	StaticMesh->CommitMeshDescription(0);
+
+	// Simple collision only: the box elements are also used for complex queries
+	StaticMesh->CreateBodySetup();
+	UBodySetup* BodySetup = StaticMesh->GetBodySetup();
+	BodySetup->Modify();
+	BodySetup->RemoveSimpleCollision();
+	BodySetup->AggGeom.BoxElems = MoveTemp(CollisionBoxes);
+	BodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+	BodySetup->InvalidatePhysicsData();
+	BodySetup->CreatePhysicsMeshes();
+
+	StaticMesh->Build(false);
+	StaticMesh->PostEditChange();
+
+	if (bNewAsset)
+	{
+		FAssetRegistryModule::AssetCreated(StaticMesh);
+	}
+	StaticMesh->MarkPackageDirty();
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Baked %d components into %s"), Components.Num(), *PackageName);
+
+	return StaticMesh;
+}
+
+UStaticMeshComponent* FParkourMeshBaker::CreateBakedComponent(AActor* Owner, UStaticMesh* StaticMesh, const FTransform& Pivot, const FString& ComponentName)
+{
+	if (!Owner || !StaticMesh)
+	{
+		return nullptr;
+	}
+
+	UStaticMeshComponent* BakedComponent = NewObject<UStaticMeshComponent>(Owner, *ComponentName);
+	BakedComponent->SetupAttachment(Owner->GetRootComponent());
+	BakedComponent->SetStaticMesh(StaticMesh);
+	BakedComponent->RegisterComponent();
+	BakedComponent->SetWorldTransform(Pivot);
+	BakedComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	BakedComponent->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+	Owner->AddInstanceComponent(BakedComponent);
+
+	return BakedComponent;
+}
+
+FString FParkourMeshBaker::MakeAssetName(const AActor* Owner, const FString& Suffix)
+{
+	const UWorld* World = Owner ? Owner->GetWorld() : nullptr;
+	const FString LevelName = World ? World->GetName() : TEXT("Level");
+	const FString OwnerName = Owner ? Owner->GetName() : TEXT("Actor");
+	return FString::Printf(TEXT("SM_%s_%s_%s"), *LevelName, *OwnerName, *Suffix);
+}
+
+#endif // WITH_EDITOR
@@ -0,0 +1,37 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+class AActor;
+class UProceduralMeshComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/**
+ * Converts generated procedural blockout geometry into static mesh assets.
+ *
+ * All sections of the given components are merged into a single LOD0 mesh description
+ * (relative to a pivot transform) and every component contributes one simple box
+ * collision element, so the baked asset renders and collides like hand-built geometry.
+ */
+class FParkourMeshBaker
+{
+public:
+	/**
+	 * Bake components into the asset PackagePath/AssetName, creating or overwriting it.
+	 * Returns nullptr if there was no geometry to bake or the package could not be created.
+	 */
+	static UStaticMesh* BakeToStaticMesh(const TArray<UProceduralMeshComponent*>& Components, const FTransform& Pivot, const FString& PackagePath, const FString& AssetName);
+
+	/** Create and register a static mesh component on Owner that displays a baked asset at Pivot */
+	static UStaticMeshComponent* CreateBakedComponent(AActor* Owner, UStaticMesh* StaticMesh, const FTransform& Pivot, const FString& ComponentName);
+
+	/** Asset name for a baked mesh of Owner, unique per level */
+	static FString MakeAssetName(const AActor* Owner, const FString& Suffix);
+};
+
+#endif // WITH_EDITOR
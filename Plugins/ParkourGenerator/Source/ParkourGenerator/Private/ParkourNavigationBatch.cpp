@@ -0,0 +1,81 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourNavigationBatch.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+
+namespace ParkourNavigationBatch
+{
+	struct FWorldBatch
+	{
+		int32 Depth = 0;
+		bool bLocked = false;
+		FBox DirtyBounds = FBox(ForceInit);
+	};
+
+	static TMap<TWeakObjectPtr<UWorld>, FWorldBatch> Batches;
+}
+
+void FParkourNavigationBatch::Begin(UWorld* World)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	ParkourNavigationBatch::FWorldBatch& Batch = ParkourNavigationBatch::Batches.FindOrAdd(World);
+	if (Batch.Depth++ > 0)
+	{
+		return;
+	}
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	{
+		NavSys->AddNavigationBuildLock(ENavigationBuildLock::Custom);
+		Batch.bLocked = true;
+	}
+}
+
+void FParkourNavigationBatch::End(UWorld* World)
+{
+	ParkourNavigationBatch::FWorldBatch* Batch = World ? ParkourNavigationBatch::Batches.Find(World) : nullptr;
+	if (!Batch || --Batch->Depth > 0)
+	{
+		return;
+	}
+
+	const bool bLocked = Batch->bLocked;
+	const FBox DirtyBounds = Batch->DirtyBounds;
+	ParkourNavigationBatch::Batches.Remove(World);
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavSys)
+	{
+		return;
+	}
+
+	// Unlocking must not rebuild everything, the one dirty area below covers what changed
+	if (bLocked)
+	{
+		NavSys->RemoveNavigationBuildLock(ENavigationBuildLock::Custom, UNavigationSystemV1::ELockRemovalRebuildAction::NoRebuild);
+	}
+
+	if (DirtyBounds.IsValid)
+	{
+		NavSys->AddDirtyArea(DirtyBounds, ENavigationDirtyFlag::All);
+	}
+}
+
+void FParkourNavigationBatch::AddDirtyComponent(const UPrimitiveComponent* Component)
+{
+	if (!Component || !Component->IsRegistered())
+	{
+		return;
+	}
+
+	if (ParkourNavigationBatch::FWorldBatch* Batch = ParkourNavigationBatch::Batches.Find(Component->GetWorld()))
+	{
+		Batch->DirtyBounds += Component->Bounds.GetBox();
+	}
+}
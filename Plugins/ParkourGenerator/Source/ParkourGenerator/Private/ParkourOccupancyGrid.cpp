@@ -0,0 +1,140 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourOccupancyGrid.h"
+#include "ParkourLLM.h"
+
+void FParkourOccupancyGrid::Build(const FBox& InBounds, float InCellSize, const TArray<FBox>& Occupied)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Environment);
+
+	Bounds = InBounds;
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	Dims = FIntVector::ZeroValue;
+	Cells.Empty();
+
+	if (!Bounds.IsValid)
+	{
+		return;
+	}
+
+	const FVector Size = Bounds.GetSize();
+	auto GetDims = [this, &Size]()
+	{
+		return FIntVector(
+			FMath::Max(FMath::CeilToInt(Size.X / CellSize), 1),
+			FMath::Max(FMath::CeilToInt(Size.Y / CellSize), 1),
+			FMath::Max(FMath::CeilToInt(Size.Z / CellSize), 1));
+	};
+
+	Dims = GetDims();
+	while ((int64)Dims.X * Dims.Y * Dims.Z > MaxCells)
+	{
+		CellSize *= 2.0f;
+		Dims = GetDims();
+	}
+
+	if (CellSize > InCellSize)
+	{
+		UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Occupancy grid cells enlarged to %.0f cm to fit %.0f x %.0f x %.0f cm"), CellSize, Size.X, Size.Y, Size.Z);
+	}
+
+	Cells.Init(false, Dims.X * Dims.Y * Dims.Z);
+
+	// Boxes are filled one X row at a time
+	for (const FBox& Box : Occupied)
+	{
+		FIntVector Min, Max;
+		if (!GetCellRange(Box, true, Min, Max))
+		{
+			continue;
+		}
+
+		for (int32 Z = Min.Z; Z <= Max.Z; Z++)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+			{
+				Cells.SetRange(GetIndex(Min.X, Y, Z), Max.X - Min.X + 1, true);
+			}
+		}
+	}
+}
+
+bool FParkourOccupancyGrid::GetCellRange(const FBox& Box, bool bCentersInside, FIntVector& OutMin, FIntVector& OutMax) const
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+
+	const FVector Min = (Box.Min - Bounds.Min) / CellSize;
+	const FVector Max = (Box.Max - Bounds.Min) / CellSize;
+
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		// Cell i spans [i, i + 1) and has its center at i + 0.5
+		const int32 First = bCentersInside ? FMath::CeilToInt(Min[Axis] - 0.5f) : FMath::FloorToInt(Min[Axis]);
+		const int32 Last = bCentersInside ? FMath::FloorToInt(Max[Axis] - 0.5f) : FMath::FloorToInt(Max[Axis]);
+
+		OutMin[Axis] = FMath::Max(First, 0);
+		OutMax[Axis] = FMath::Min(Last, Dims[Axis] - 1);
+		if (OutMin[Axis] > OutMax[Axis])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FParkourOccupancyGrid::IsOccupied(const FVector& Point) const
+{
+	FIntVector Min, Max;
+	return GetCellRange(FBox(Point, Point), false, Min, Max) && Cells[GetIndex(Min.X, Min.Y, Min.Z)];
+}
+
+bool FParkourOccupancyGrid::IsBoxFree(const FBox& Box, FVector* OutBlocked) const
+{
+	FIntVector Min, Max;
+	if (!GetCellRange(Box, true, Min, Max))
+	{
+		return true;
+	}
+
+	for (int32 Z = Min.Z; Z <= Max.Z; Z++)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+		{
+			const int32 Row = GetIndex(0, Y, Z);
+			for (int32 X = Min.X; X <= Max.X; X++)
+			{
+				if (Cells[Row + X])
+				{
+					if (OutBlocked)
+					{
+						*OutBlocked = GetCellCenter(X, Y, Z);
+					}
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FParkourOccupancyGrid::IsCorridorFree(const FVector& Start, const FVector& End, float HalfWidth, float Height, FVector* OutBlocked) const
+{
+	const FVector Extent(HalfWidth, HalfWidth, 0.0f);
+	const int32 NumSteps = FMath::Max(FMath::CeilToInt(FVector::Dist(Start, End) / CellSize), 1);
+
+	for (int32 Step = 0; Step <= NumSteps; Step++)
+	{
+		const FVector Point = FMath::Lerp(Start, End, (float)Step / NumSteps);
+		if (!IsBoxFree(FBox(Point - Extent, Point + Extent + FVector(0.0f, 0.0f, Height)), OutBlocked))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
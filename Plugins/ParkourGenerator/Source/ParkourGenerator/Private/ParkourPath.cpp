@@ -1,14 +1,34 @@
 // Copyright ParkourGeneratorPro. All Rights Reserved.
 
 #include "ParkourPath.h"
+#include "ParkourPlayArea.h"
+#include "ParkourRooftopIndex.h"
+#include "ParkourWorldSubsystem.h"
 #include "ProceduralMeshComponent.h"
-#include "DrawDebugHelpers.h"
+#include "Components/StaticMeshComponent.h"
+#include "ParkourGeneratorSettings.h"
+#include "ParkourMeshBaker.h"
+#include "ParkourGenerationCache.h"
+#include "ParkourPreviewComponent.h"
+#include "ParkourReachabilityTable.h"
+#include "ParkourLLM.h"
+#include "ParkourNavigationBatch.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Algo/Sort.h"
+#include "Algo/Reverse.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "TimerManager.h"
+#endif
 
 AParkourPath::AParkourPath()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// Only ticks while streaming
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// Create root component
 	USceneComponent* Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
@@ -32,31 +52,95 @@ AParkourPath::AParkourPath()
 	PathSpline->SetUnselectedSplineSegmentColor(FLinearColor(0.0f, 0.8f, 0.2f));
 	PathSpline->SetSelectedSplineSegmentColor(FLinearColor(0.0f, 1.0f, 0.0f));
 	PathSpline->ScaleVisualizationWidth = 10.0f;
+
+	// Create preview component (stripped from cooked builds)
+	PreviewComponent = CreateEditorOnlyDefaultSubobject<UParkourPreviewComponent>(TEXT("Preview"));
+	if (PreviewComponent)
+	{
+		PreviewComponent->SetupAttachment(Root);
+	}
 }
 
 void AParkourPath::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (bStreamingMode)
+	{
+		StartStreaming(StreamingTarget);
+	}
+}
+
+void AParkourPath::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UpdateStreaming();
 }
 
 void AParkourPath::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
 
-	if (bShowPlatformPreview)
+	UpdatePathBVH();
+	RequestPreviewUpdate();
+}
+
+void AParkourPath::PostLoad()
+{
+	Super::PostLoad();
+
+	// Older levels saved the transforms themselves, they become the record
+	if (GeneratedPlatformTransforms_DEPRECATED.Num() > 0)
 	{
-		UpdatePreview();
+		TArray<FTransform> RecordedPlatforms;
+		CompactLayout.GetPlatforms(RecordedPlatforms);
+		if (RecordedPlatforms.Num() == 0)
+		{
+			CompactLayout.SetPlatforms(GeneratedPlatformTransforms_DEPRECATED, LayoutStorage == EParkourLayoutStorage::CompactLayout);
+		}
+		GeneratedPlatformTransforms_DEPRECATED.Empty();
+	}
+
+	// Transforms are not saved, restore them from the compact record
+	CompactLayout.GetPlatforms(GeneratedPlatformTransforms);
+	CompactLayout.GetRooftopPlatforms(GeneratedPlatformOnRooftop);
+
+	// Transient meshes come back as null references
+	GeneratedPlatformMeshes.Remove(nullptr);
+
+	bLayoutRebuildPending = LayoutStorage == EParkourLayoutStorage::CompactLayout
+		&& GeneratedPlatformOnRooftop.Contains(false)
+		&& GeneratedPlatformMeshes.Num() == 0
+		&& BakedPlatformMeshes.Num() == 0;
+}
+
+void AParkourPath::PostRegisterAllComponents()
+{
+	Super::PostRegisterAllComponents();
+
+	UpdatePathBVH();
+
+	if (bLayoutRebuildPending)
+	{
+		bLayoutRebuildPending = false;
+		CreatePlatformMeshes();
+
+		UE_LOG(LogTemp, Log, TEXT("Rebuilt %d parkour platforms from compact layout"), GeneratedPlatformTransforms.Num());
 	}
 }
 
 #if WITH_EDITOR
 void AParkourPath::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
+	// Construction reruns in Super and updates the preview, at the detail this change type calls for
+	PreviewChangeType = PropertyChangedEvent.ChangeType;
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	PreviewChangeType = EPropertyChangeType::Unspecified;
 
-	if (bShowPlatformPreview)
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(AParkourPath, LayoutStorage))
 	{
-		UpdatePreview();
+		ApplyLayoutStorage();
 	}
 }
 #endif
@@ -67,6 +151,12 @@ bool AParkourPath::IsJumpValid(const FVector& FromPoint, const FVector& ToPoint)
 	const float HorizontalDist = FVector(Diff.X, Diff.Y, 0).Size();
 	const float VerticalDist = Diff.Z;
 
+	// The margin shrinks the reachable envelope, drops are not made harder by it
+	if (UsesReachabilityTable())
+	{
+		return ReachabilityTable->IsReachable(HorizontalDist / JumpSafetyMargin, VerticalDist > 0 ? VerticalDist / JumpSafetyMargin : VerticalDist);
+	}
+
 	// Check horizontal distance
 	if (HorizontalDist > GetSafeJumpDistance())
 	{
@@ -90,28 +180,161 @@ bool AParkourPath::IsJumpValid(const FVector& FromPoint, const FVector& ToPoint)
 	return true;
 }
 
-TArray<FTransform> AParkourPath::CalculatePlatformPositions()
+float AParkourPath::GetSafeJumpDistance() const
 {
-	TArray<FTransform> Platforms;
+	return (UsesReachabilityTable() ? ReachabilityTable->BakedMaxJumpDistance : MaxJumpDistance) * JumpSafetyMargin;
+}
 
-	if (!PathSpline || PathSpline->GetNumberOfSplinePoints() < 2)
+float AParkourPath::GetSafeJumpHeight() const
+{
+	return (UsesReachabilityTable() ? ReachabilityTable->BakedMaxJumpHeight : MaxJumpHeight) * JumpSafetyMargin;
+}
+
+float AParkourPath::GetMaxJumpReach() const
+{
+	// Matches IsJumpValid, which scales the table lookup by the margin
+	return UsesReachabilityTable() ? ReachabilityTable->BakedMaxReach * JumpSafetyMargin : GetSafeJumpDistance();
+}
+
+bool AParkourPath::UsesReachabilityTable() const
+{
+	return ReachabilityTable && ReachabilityTable->IsBaked();
+}
+
+float AParkourPath::GetJumpDifficulty(const FVector& FromPoint, const FVector& ToPoint) const
+{
+	const float SafeDistance = FMath::Max(GetSafeJumpDistance(), KINDA_SMALL_NUMBER);
+	const float SafeHeight = FMath::Max(GetSafeJumpHeight(), KINDA_SMALL_NUMBER);
+
+	const FVector Diff = ToPoint - FromPoint;
+	const float HorizontalRatio = FVector(Diff.X, Diff.Y, 0).Size() / SafeDistance;
+	const float VerticalRatio = Diff.Z > 0 ? Diff.Z / SafeHeight : -Diff.Z / (SafeHeight * 3.0f);
+
+	return FMath::Clamp(FMath::Max(HorizontalRatio, VerticalRatio), 0.0f, 1.0f);
+}
+
+void AParkourPath::UpdatePathBVH()
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_PathSolve);
+
+	if (PathSpline)
 	{
-		return Platforms;
+		// 1cm from the curve, segments split at 1m for height tests
+		PathBVH.Build(*PathSpline, 1.0f, 100.0f);
+	}
+}
+
+FBox AParkourPath::GetPlatformClearanceBox(const FTransform& Platform, float Margin) const
+{
+	// Depth runs along local X and width along local Y, as in CreatePlatformGeometry
+	const float HalfDepth = PlatformDepth * Platform.GetScale3D().X * 0.5f + Margin;
+	const float HalfWidth = PlatformWidth * Platform.GetScale3D().Y * 0.5f + Margin;
+
+	// Axis aligned around the rotated platform, slightly larger than needed for turned platforms
+	const FBox Local(FVector(-HalfDepth, -HalfWidth, 0.0f), FVector(HalfDepth, HalfWidth, HeadroomHeight));
+	return Local.TransformBy(FTransform(Platform.GetRotation(), Platform.GetLocation()));
+}
+
+FBox AParkourPath::GetClearanceBounds(const TArray<FTransform>& Platforms) const
+{
+	FBox Bounds(ForceInit);
+	for (const FTransform& Platform : Platforms)
+	{
+		Bounds += GetPlatformClearanceBox(Platform, LandingMargin + RunUpWidth * 0.5f);
 	}
+	return Bounds;
+}
+
+const FParkourJumpValidation& AParkourPath::UpdateJumpValidation()
+{
+	JumpValidation.Update(*this, GeneratedPlatformTransforms);
+	return JumpValidation;
+}
+
+bool AParkourPath::FindClearanceIssues(const FParkourOccupancyGrid& Grid, const TArray<FTransform>& Platforms, TArray<FParkourClearanceIssue>& OutIssues) const
+{
+	OutIssues.Reset();
 
-	// Initialize random stream
-	if (RandomSeed != 0)
+	for (int32 i = 0; i < Platforms.Num(); i++)
 	{
-		RandomStream.Initialize(RandomSeed);
+		FParkourClearanceIssue Issue;
+		Issue.PlatformIndex = i;
+
+		// The first platform is started on, not landed on or run up to
+		if (!Grid.IsBoxFree(GetPlatformClearanceBox(Platforms[i], 0.0f), &Issue.BlockedLocation))
+		{
+			Issue.Check = EParkourClearanceCheck::Headroom;
+		}
+		else if (i > 0 && !Grid.IsBoxFree(GetPlatformClearanceBox(Platforms[i], LandingMargin), &Issue.BlockedLocation))
+		{
+			Issue.Check = EParkourClearanceCheck::LandingZone;
+		}
+		else if (i > 0 && !Grid.IsCorridorFree(Platforms[i - 1].GetLocation(), Platforms[i].GetLocation(),
+			RunUpWidth * 0.5f, HeadroomHeight, &Issue.BlockedLocation))
+		{
+			Issue.Check = EParkourClearanceCheck::RunUp;
+		}
+		else
+		{
+			continue;
+		}
+
+		OutIssues.Add(Issue);
 	}
-	else
+
+	return OutIssues.Num() == 0;
+}
+
+bool AParkourPath::SnapToRooftop(const FParkourRooftopIndex& Rooftops, const FVector& From, FVector& InOutLocation) const
+{
+	auto IsReachable = [this, &From](const FVector& Candidate)
+	{
+		return IsJumpValid(From, Candidate);
+	};
+
+	return Rooftops.FindClosestRoofPoint(InOutLocation, RooftopSearchRadius, GetSafeJumpHeight(), IsReachable, InOutLocation);
+}
+
+TArray<FTransform> AParkourPath::SolvePlatforms(int32 Seed, TArray<bool>& OutOnRooftop, FParkourSolveStats* Stats) const
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_PathSolve);
+
+	FRandomStream RandomStream(Seed);
+	return CalculatePlatformPositions(RandomStream, OutOnRooftop, Stats);
+}
+
+TArray<FTransform> AParkourPath::CalculatePlatformPositions(FRandomStream& RandomStream, TArray<bool>& OutOnRooftop, FParkourSolveStats* Stats) const
+{
+	TArray<FTransform> Platforms;
+	OutOnRooftop.Reset();
+
+	if (!PathSpline || PathSpline->GetNumberOfSplinePoints() < 2)
 	{
-		RandomStream.GenerateNewSeed();
+		return Platforms;
 	}
 
 	const float SplineLength = PathSpline->GetSplineLength();
 	const float SafeJumpDist = GetSafeJumpDistance();
 
+	if (PlacementMode == EParkourPlacementMode::Optimal)
+	{
+		if (CalculateOptimalPlatformPositions(RandomStream, Platforms, Stats))
+		{
+			OutOnRooftop.Init(false, Platforms.Num());
+			return Platforms;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: %s falls back to greedy placement"), *GetName());
+	}
+
+	// Roofs are inset by half a platform so the player lands fully on them
+	FParkourRooftopIndex RooftopIndex;
+	if (bUseBuildingRooftops && RooftopSourceArea)
+	{
+		RooftopIndex.Build(RooftopSourceArea->GeneratedBuildingBoxes, SafeJumpDist, FMath::Min(PlatformWidth, PlatformDepth) * 0.5f);
+	}
+	const FParkourRooftopIndex* Rooftops = RooftopIndex.IsEmpty() ? nullptr : &RooftopIndex;
+
 	// Calculate approximate number of platforms needed
 	int32 EstimatedPlatforms = FMath::CeilToInt(SplineLength / SafeJumpDist) + 1;
 	EstimatedPlatforms = FMath::Clamp(EstimatedPlatforms, MinPlatforms, MaxPlatforms);
@@ -126,6 +349,7 @@ TArray<FTransform> AParkourPath::CalculatePlatformPositions()
 	FVector FirstDir = PathSpline->GetDirectionAtDistanceAlongSpline(0, ESplineCoordinateSpace::World);
 	FirstTransform.SetRotation(FirstDir.ToOrientationQuat());
 	Platforms.Add(FirstTransform);
+	OutOnRooftop.Add(false);
 
 	// Generate platforms along the path
 	while (CurrentDistance < SplineLength)
@@ -150,9 +374,25 @@ TArray<FTransform> AParkourPath::CalculatePlatformPositions()
 
 		FVector NextPosition = PathSpline->GetLocationAtDistanceAlongSpline(TestDistance, ESplineCoordinateSpace::World);
 		FVector NextDirection = PathSpline->GetDirectionAtDistanceAlongSpline(TestDistance, ESplineCoordinateSpace::World);
+		if (Stats)
+		{
+			Stats->SplineSamples++;
+		}
+
+		// A reachable roof replaces the platform, its building is the geometry
+		if (Rooftops && SnapToRooftop(*Rooftops, LastPosition, NextPosition))
+		{
+			FTransform RoofTransform;
+			RoofTransform.SetLocation(NextPosition);
+			RoofTransform.SetRotation(NextDirection.ToOrientationQuat());
 
+			Platforms.Add(RoofTransform);
+			OutOnRooftop.Add(true);
+			LastPosition = NextPosition;
+			CurrentDistance = TestDistance;
+		}
 		// Check if jump is valid
-		if (IsJumpValid(LastPosition, NextPosition))
+		else if (IsJumpValid(LastPosition, NextPosition))
 		{
 			// Valid jump - add platform
 			FTransform NewTransform;
@@ -167,12 +407,18 @@ TArray<FTransform> AParkourPath::CalculatePlatformPositions()
 			}
 
 			Platforms.Add(NewTransform);
+			OutOnRooftop.Add(false);
 			LastPosition = NextPosition;
 			CurrentDistance = TestDistance;
 		}
 		else
 		{
 			// Invalid jump - need intermediate platforms
+			if (Stats)
+			{
+				Stats->RejectedJumps++;
+			}
+
 			FTransform FromTransform;
 			FromTransform.SetLocation(LastPosition);
 
@@ -180,7 +426,7 @@ TArray<FTransform> AParkourPath::CalculatePlatformPositions()
 			ToTransform.SetLocation(NextPosition);
 			ToTransform.SetRotation(NextDirection.ToOrientationQuat());
 
-			AddIntermediatePlatforms(Platforms, FromTransform, ToTransform);
+			AddIntermediatePlatforms(RandomStream, Platforms, OutOnRooftop, FromTransform, ToTransform, Rooftops);
 
 			// Update last position to the newly added platform
 			if (Platforms.Num() > 0)
@@ -206,13 +452,164 @@ TArray<FTransform> AParkourPath::CalculatePlatformPositions()
 	return Platforms;
 }
 
-void AParkourPath::AddIntermediatePlatforms(TArray<FTransform>& Platforms, const FTransform& From, const FTransform& To)
+bool AParkourPath::CalculateOptimalPlatformPositions(FRandomStream& RandomStream, TArray<FTransform>& OutPlatforms, FParkourSolveStats* Stats) const
+{
+	const float SplineLength = PathSpline->GetSplineLength();
+	const float Spacing = FMath::Max(OptimizerSampleSpacing, 1.0f);
+
+	// Candidate positions along the spline, the last one at its end
+	const int32 NumCandidates = FMath::CeilToInt(SplineLength / Spacing) + 1;
+	TArray<float> CandidateDistances;
+	TArray<FVector> CandidatePositions;
+	CandidateDistances.SetNumUninitialized(NumCandidates);
+	CandidatePositions.SetNumUninitialized(NumCandidates);
+	for (int32 i = 0; i < NumCandidates; i++)
+	{
+		CandidateDistances[i] = FMath::Min(i * Spacing, SplineLength);
+		CandidatePositions[i] = PathSpline->GetLocationAtDistanceAlongSpline(CandidateDistances[i], ESplineCoordinateSpace::World);
+	}
+
+	if (Stats)
+	{
+		Stats->SplineSamples += NumCandidates;
+	}
+
+	// Predecessors of every candidate are the earlier ones within a jump's horizontal reach in a straight line (the k
+	// of O(n*k)). The spline may loop back, so samples far apart along it can still be in reach of each other
+	const float CellSize = FMath::Max(GetMaxJumpReach(), 1.0f);
+	auto GetCell = [CellSize](const FVector& Position)
+	{
+		return FIntPoint(FMath::FloorToInt(Position.X / CellSize), FMath::FloorToInt(Position.Y / CellSize));
+	};
+
+	TMap<FIntPoint, TArray<int32>> Grid;
+	for (int32 i = 0; i < NumCandidates; i++)
+	{
+		Grid.FindOrAdd(GetCell(CandidatePositions[i])).Add(i);
+	}
+
+	TArray<TArray<int32>> Predecessors;
+	Predecessors.SetNum(NumCandidates);
+	for (int32 i = 1; i < NumCandidates; i++)
+	{
+		const FIntPoint Cell = GetCell(CandidatePositions[i]);
+		for (int32 DX = -1; DX <= 1; DX++)
+		{
+			for (int32 DY = -1; DY <= 1; DY++)
+			{
+				if (const TArray<int32>* InCell = Grid.Find(Cell + FIntPoint(DX, DY)))
+				{
+					for (int32 j : *InCell)
+					{
+						if (j < i)
+						{
+							Predecessors[i].Add(j);
+						}
+					}
+				}
+			}
+		}
+
+		// Farthest predecessor first, so ties favour longer jumps
+		Predecessors[i].Sort();
+	}
+
+	// Shortest chain to the end, weighing each jump by how far it is from the target difficulty
+	TArray<float> Cost;
+	TArray<int32> Previous;
+	auto SolveChain = [&](float Evenness, TArray<int32>& OutChain)
+	{
+		Cost.Init(MAX_flt, NumCandidates);
+		Previous.Init(INDEX_NONE, NumCandidates);
+		Cost[0] = 0.0f;
+
+		for (int32 i = 1; i < NumCandidates; i++)
+		{
+			for (int32 j : Predecessors[i])
+			{
+				if (Cost[j] == MAX_flt)
+				{
+					continue;
+				}
+
+				if (!IsJumpValid(CandidatePositions[j], CandidatePositions[i]))
+				{
+					if (Stats)
+					{
+						Stats->RejectedJumps++;
+					}
+					continue;
+				}
+
+				const float JumpCost = Cost[j] + 1.0f + Evenness * FMath::Square(GetJumpDifficulty(CandidatePositions[j], CandidatePositions[i]) - OptimizerTargetDifficulty);
+				if (JumpCost < Cost[i])
+				{
+					Cost[i] = JumpCost;
+					Previous[i] = j;
+				}
+			}
+		}
+
+		OutChain.Reset();
+		if (Previous[NumCandidates - 1] == INDEX_NONE)
+		{
+			return false;
+		}
+
+		for (int32 i = NumCandidates - 1; i != INDEX_NONE; i = Previous[i])
+		{
+			OutChain.Add(i);
+		}
+		Algo::Reverse(OutChain);
+		return true;
+	};
+
+	TArray<int32> Chain;
+	if (!SolveChain(OptimizerEvenness, Chain))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: %s has a jump no candidate spacing can make"), *GetName());
+		return false;
+	}
+
+	// Even jumps may take more platforms than the fewest possible, those still reach the end
+	if (Chain.Num() > MaxPlatforms && OptimizerEvenness > 0.0f)
+	{
+		SolveChain(0.0f, Chain);
+	}
+
+	if (Chain.Num() > MaxPlatforms)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: %s needs at least %d platforms to reach its end, more than MaxPlatforms (%d)"), *GetName(), Chain.Num(), MaxPlatforms);
+		return false;
+	}
+
+	OutPlatforms.Reset(Chain.Num());
+	for (int32 Candidate : Chain)
+	{
+		FTransform NewTransform;
+		NewTransform.SetLocation(CandidatePositions[Candidate]);
+		NewTransform.SetRotation(PathSpline->GetDirectionAtDistanceAlongSpline(CandidateDistances[Candidate], ESplineCoordinateSpace::World).ToOrientationQuat());
+
+		// Size variation does not change the spacing, only the platforms
+		if (bAllowPlatformVariation)
+		{
+			float ScaleVariation = 1.0f + RandomStream.FRandRange(-PlatformSizeVariation * 0.5f, PlatformSizeVariation * 0.5f);
+			NewTransform.SetScale3D(FVector(ScaleVariation, ScaleVariation, 1.0f));
+		}
+
+		OutPlatforms.Add(NewTransform);
+	}
+
+	return true;
+}
+
+void AParkourPath::AddIntermediatePlatforms(FRandomStream& RandomStream, TArray<FTransform>& Platforms, TArray<bool>& OnRooftop, const FTransform& From, const FTransform& To, const FParkourRooftopIndex* Rooftops) const
 {
 	const FVector FromPos = From.GetLocation();
 	const FVector ToPos = To.GetLocation();
 	const FVector Diff = ToPos - FromPos;
 	const float TotalDistance = Diff.Size();
-	const float SafeJumpDist = GetSafeJumpDistance();
+	const float MaxReach = GetMaxJumpReach();
 	const float SafeJumpH = GetSafeJumpHeight();
 
 	// Calculate number of intermediate platforms needed
@@ -220,9 +617,9 @@ void AParkourPath::AddIntermediatePlatforms(TArray<FTransform>& Platforms, const
 
 	// Check horizontal requirement
 	float HorizontalDist = FVector(Diff.X, Diff.Y, 0).Size();
-	if (HorizontalDist > SafeJumpDist)
+	if (HorizontalDist > MaxReach)
 	{
-		NumIntermediates = FMath::Max(NumIntermediates, FMath::CeilToInt(HorizontalDist / SafeJumpDist));
+		NumIntermediates = FMath::Max(NumIntermediates, FMath::CeilToInt(HorizontalDist / MaxReach));
 	}
 
 	// Check vertical requirement (for upward jumps)
@@ -233,7 +630,14 @@ void AParkourPath::AddIntermediatePlatforms(TArray<FTransform>& Platforms, const
 		NumIntermediates = FMath::Max(NumIntermediates, VerticalIntermediates);
 	}
 
-	// Add intermediate platforms
+	// The full reach only holds for the longest drops, add platforms until the equal jumps between them are valid
+	while (NumIntermediates < MaxPlatforms && !IsJumpValid(FromPos, FromPos + Diff / (NumIntermediates + 1)))
+	{
+		NumIntermediates++;
+	}
+
+	// Plan all intermediate positions first, a snapped one has to reach the next of them
+	TArray<FVector, TInlineAllocator<8>> Planned;
 	for (int32 i = 1; i <= NumIntermediates; i++)
 	{
 		float Alpha = (float)i / (float)(NumIntermediates + 1);
@@ -247,30 +651,38 @@ void AParkourPath::AddIntermediatePlatforms(TArray<FTransform>& Platforms, const
 			IntermediatePos += RightVec * OffsetAmount;
 		}
 
+		Planned.Add(IntermediatePos);
+	}
+
+	// Add intermediate platforms
+	for (int32 i = 0; i < Planned.Num(); i++)
+	{
+		FVector IntermediatePos = Planned[i];
+		const FVector NextTarget = Planned.IsValidIndex(i + 1) ? Planned[i + 1] : ToPos;
+
+		// Prefer a roof in reach of the previous platform over a floating one, as long as the next one is in reach of the roof
+		FVector RoofPos = IntermediatePos;
+		const bool bRooftop = Rooftops && SnapToRooftop(*Rooftops, Platforms.Last().GetLocation(), RoofPos) && IsJumpValid(RoofPos, NextTarget);
+		if (bRooftop)
+		{
+			IntermediatePos = RoofPos;
+		}
+
 		FTransform IntermediateTransform;
 		IntermediateTransform.SetLocation(IntermediatePos);
 		IntermediateTransform.SetRotation(To.GetRotation());
 
 		Platforms.Add(IntermediateTransform);
+		OnRooftop.Add(bRooftop);
 	}
 
 	// Add final platform
 	Platforms.Add(To);
+	OnRooftop.Add(false);
 }
 
-UProceduralMeshComponent* AParkourPath::CreatePlatformMesh(const FTransform& PlatformTransform, int32 Index)
+void AParkourPath::CreatePlatformGeometry(UProceduralMeshComponent* PlatformMesh, float Width, float Depth, float Thickness) const
 {
-	// Create procedural mesh component
-	FString MeshName = FString::Printf(TEXT("Platform_%d"), Index);
-	UProceduralMeshComponent* PlatformMesh = NewObject<UProceduralMeshComponent>(this, *MeshName);
-	PlatformMesh->SetupAttachment(RootComponent);
-	PlatformMesh->RegisterComponent();
-
-	// Get platform dimensions with any scale variation
-	float Width = PlatformWidth * PlatformTransform.GetScale3D().X;
-	float Depth = PlatformDepth * PlatformTransform.GetScale3D().Y;
-	float Thickness = PlatformThickness;
-
 	// Half dimensions for vertex positions
 	float HW = Width * 0.5f;
 	float HD = Depth * 0.5f;
@@ -333,11 +745,29 @@ UProceduralMeshComponent* AParkourPath::CreatePlatformMesh(const FTransform& Pla
 	}
 
 	// Create the mesh section
-	PlatformMesh->CreateMeshSection(0, Vertices, Triangles, Normals, UVs, VertexColors, TArray<FProcMeshTangent>(), true);
+	ParkourLLM::CreateMeshSection(*PlatformMesh, 0, Vertices, Triangles, Normals, UVs, VertexColors);
+}
+
+UProceduralMeshComponent* AParkourPath::CreatePlatformMesh(const FTransform& PlatformTransform, int32 Index)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_MeshData);
+
+	// Create procedural mesh component
+	FString MeshName = FString::Printf(TEXT("Platform_%d"), Index);
+	UProceduralMeshComponent* PlatformMesh = NewObject<UProceduralMeshComponent>(this, *MeshName, FParkourCompactLayout::GetComponentFlags(LayoutStorage));
+	PlatformMesh->SetupAttachment(RootComponent);
+	PlatformMesh->RegisterComponent();
+
+	// Get platform dimensions with any scale variation
+	float Width = PlatformWidth * PlatformTransform.GetScale3D().X;
+	float Depth = PlatformDepth * PlatformTransform.GetScale3D().Y;
+	float Thickness = PlatformThickness;
+
+	CreatePlatformGeometry(PlatformMesh, Width, Depth, Thickness);
 
 	// Set world transform
 	FVector Location = PlatformTransform.GetLocation();
-	Location.Z -= HT; // Offset so top of platform is at the path height
+	Location.Z -= Thickness * 0.5f; // Offset so top of platform is at the path height
 	PlatformMesh->SetWorldLocation(Location);
 	PlatformMesh->SetWorldRotation(PlatformTransform.GetRotation().Rotator());
 
@@ -350,28 +780,482 @@ UProceduralMeshComponent* AParkourPath::CreatePlatformMesh(const FTransform& Pla
 
 void AParkourPath::GenerateParkour()
 {
+	LLM_SCOPE_BYTAG(ParkourGenerator_PathSolve);
+
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	FParkourGenerationReport Report;
+	const double StartTime = Report.Start();
+	Report.Name = GetName();
+
 	// Clear any existing platforms
 	ClearGeneratedParkour();
 
-	// Calculate platform positions
-	GeneratedPlatformTransforms = CalculatePlatformPositions();
+	bool bCacheHit = false;
+
+#if WITH_EDITOR
+	// Unchanged inputs with a fixed seed give the same layout, reuse it from the DDC
+	const FString CacheKey = FParkourGenerationCache::MakePathKey(*this);
+	bCacheHit = FParkourGenerationCache::GetPlatforms(CacheKey, GeneratedPlatformTransforms, GeneratedPlatformOnRooftop);
+#endif
+
+	// Seed 0 asks for a new layout every time
+	const int32 Seed = RandomSeed != 0 ? RandomSeed : FMath::Rand();
+	CompactLayout.Seed = Seed;
+
+	if (!bCacheHit)
+	{
+		// Calculate platform positions
+		const double SolveStart = FPlatformTime::Seconds();
+		FParkourSolveStats Stats;
+		GeneratedPlatformTransforms = SolvePlatforms(Seed, GeneratedPlatformOnRooftop, &Stats);
+		Report.SolveTimeMs = FParkourGenerationReport::MillisecondsSince(SolveStart);
+		Report.AddSolveStats(Stats);
+
+#if WITH_EDITOR
+		FParkourGenerationCache::PutPlatforms(CacheKey, GeneratedPlatformTransforms, GeneratedPlatformOnRooftop);
+#endif
+	}
+
+	// Record the layout, this is what gets saved with the level
+	CompactLayout.SetPlatforms(GeneratedPlatformTransforms, LayoutStorage == EParkourLayoutStorage::CompactLayout);
+	CompactLayout.SetRooftopPlatforms(GeneratedPlatformOnRooftop);
 
 	// Create platform meshes
+	const double MeshStart = FPlatformTime::Seconds();
+	CommitPlatformMeshes();
+	Report.MeshTimeMs = FParkourGenerationReport::MillisecondsSince(MeshStart);
+
+	Report.Seed = Seed;
+	Report.CacheHits = bCacheHit ? 1 : 0;
+	Report.Platforms = GeneratedPlatformTransforms.Num();
+	Report.AddMeshes(GeneratedPlatformMeshes);
+	Report.Finish(StartTime);
+	LastGenerationReport = Report;
+
+	UE_LOG(LogTemp, Log, TEXT("Generated %d parkour platforms, %d on rooftops%s in %.1f ms"), GeneratedPlatformTransforms.Num(), CompactLayout.RooftopPlatforms.Num(), bCacheHit ? TEXT(" (cached)") : TEXT(""), Report.TotalTimeMs);
+}
+
+void AParkourPath::ApplyPlatformLayout(const TArray<FTransform>& PlatformTransforms, int32 Seed, const TArray<bool>& PlatformsOnRooftop)
+{
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	ApplyPlatformLayoutDeferred(PlatformTransforms, Seed, PlatformsOnRooftop);
+
+	while (CreateNextPendingMesh())
+	{
+	}
+}
+
+void AParkourPath::ApplyPlatformLayoutDeferred(const TArray<FTransform>& PlatformTransforms, int32 Seed, const TArray<bool>& PlatformsOnRooftop)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_PathSolve);
+
+	// The old meshes go in the same time slices the new ones are created in
+	QueueGeneratedRemoval();
+
+	GeneratedPlatformTransforms = PlatformTransforms;
+	GeneratedPlatformOnRooftop = PlatformsOnRooftop;
+	GeneratedPlatformOnRooftop.SetNumZeroed(GeneratedPlatformTransforms.Num());
+	CompactLayout.Seed = Seed;
+	CompactLayout.SetPlatforms(GeneratedPlatformTransforms, LayoutStorage == EParkourLayoutStorage::CompactLayout);
+	CompactLayout.SetRooftopPlatforms(GeneratedPlatformOnRooftop);
+
+	QueuePlatformMeshes();
+}
+
+void AParkourPath::CreatePlatformMeshes()
+{
+	QueuePlatformMeshes();
+
+	while (CreateNextPendingMesh())
+	{
+	}
+}
+
+void AParkourPath::CommitPlatformMeshes()
+{
+	QueuePlatformMeshes();
+
+	UWorld* World = GetWorld();
+	UParkourWorldSubsystem* Subsystem = World ? World->GetSubsystem<UParkourWorldSubsystem>() : nullptr;
+	if (bIncrementalGeneration && Subsystem)
+	{
+		Subsystem->RequestMeshCreation(this, nullptr);
+		return;
+	}
+
+	while (CreateNextPendingMesh())
+	{
+	}
+}
+
+void AParkourPath::QueuePlatformMeshes()
+{
+	PendingMeshes.Reset();
+	NextPendingMesh = 0;
+	bMeshCreationActive = true;
+
 	for (int32 i = 0; i < GeneratedPlatformTransforms.Num(); i++)
 	{
-		UProceduralMeshComponent* PlatformMesh = CreatePlatformMesh(GeneratedPlatformTransforms[i], i);
-		if (PlatformMesh)
+		// Roofs are walked on as they are
+		if (!GeneratedPlatformOnRooftop.IsValidIndex(i) || !GeneratedPlatformOnRooftop[i])
 		{
-			GeneratedPlatformMeshes.Add(PlatformMesh);
+			PendingMeshes.Add(i);
 		}
 	}
+}
+
+void AParkourPath::SortPendingMeshes(const FVector& ViewLocation)
+{
+	TArrayView<int32> Remaining(PendingMeshes.GetData() + NextPendingMesh, PendingMeshes.Num() - NextPendingMesh);
+	Algo::SortBy(Remaining, [this, &ViewLocation](int32 Index)
+	{
+		return FVector::DistSquared(GeneratedPlatformTransforms[Index].GetLocation(), ViewLocation);
+	});
+}
+
+bool AParkourPath::CreateNextPendingMesh()
+{
+	if (PendingRemovals.Num() > 0)
+	{
+		UPrimitiveComponent* Component = PendingRemovals.Pop(false);
+		if (Component)
+		{
+			FParkourNavigationBatch::AddDirtyComponent(Component);
+			Component->DestroyComponent();
+		}
+		return true;
+	}
+
+	if (!HasPendingMeshes())
+	{
+		PendingMeshes.Reset();
+		NextPendingMesh = 0;
+
+		if (bMeshCreationActive)
+		{
+			bMeshCreationActive = false;
+			OnGenerationCompleted.Broadcast();
+		}
+		return false;
+	}
+
+	const int32 Index = PendingMeshes[NextPendingMesh++];
+	UProceduralMeshComponent* PlatformMesh = CreatePlatformMesh(GeneratedPlatformTransforms[Index], Index);
+	if (PlatformMesh)
+	{
+		FParkourNavigationBatch::AddDirtyComponent(PlatformMesh);
+		GeneratedPlatformMeshes.Add(PlatformMesh);
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("Generated %d parkour platforms"), GeneratedPlatformTransforms.Num());
+	return true;
+}
+
+void AParkourPath::ApplyLayoutStorage()
+{
+	// Re-record so only Compact Layout storage keeps quantized transforms
+	if (GeneratedPlatformTransforms.Num() > 0)
+	{
+		CompactLayout.SetPlatforms(GeneratedPlatformTransforms, LayoutStorage == EParkourLayoutStorage::CompactLayout);
+	}
+
+	for (UProceduralMeshComponent* Mesh : GeneratedPlatformMeshes)
+	{
+		if (!Mesh)
+		{
+			continue;
+		}
+
+		if (LayoutStorage == EParkourLayoutStorage::CompactLayout)
+		{
+			Mesh->SetFlags(RF_Transient);
+		}
+		else
+		{
+			Mesh->ClearFlags(RF_Transient);
+		}
+	}
 }
 
 void AParkourPath::ClearGeneratedParkour()
 {
-	// Destroy all generated platform meshes
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	QueueGeneratedRemoval();
+
+	// Destroy all generated platform meshes and their baked replacements
+	for (UPrimitiveComponent* Component : PendingRemovals)
+	{
+		if (Component)
+		{
+			FParkourNavigationBatch::AddDirtyComponent(Component);
+			Component->DestroyComponent();
+		}
+	}
+	PendingRemovals.Empty();
+}
+
+void AParkourPath::QueueGeneratedRemoval()
+{
+	PendingRemovals.Append(GeneratedPlatformMeshes);
+	PendingRemovals.Append(BakedPlatformMeshes);
+	GeneratedPlatformMeshes.Empty();
+	BakedPlatformMeshes.Empty();
+
+	GeneratedPlatformTransforms.Empty();
+	GeneratedPlatformOnRooftop.Empty();
+	PendingMeshes.Empty();
+	NextPendingMesh = 0;
+	bMeshCreationActive = false;
+	CompactLayout.Reset();
+
+	DestroyStreamingBuffer();
+}
+
+void AParkourPath::StartStreaming(AActor* Target)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_MeshData);
+
+	if (Target)
+	{
+		StreamingTarget = Target;
+	}
+
+	ClearGeneratedParkour();
+
+	if (!PathSpline || PathSpline->GetNumberOfSplinePoints() < 1)
+	{
+		return;
+	}
+
+	// Warm-up: every component and transform slot the route will ever use is created here
+	const int32 BufferSize = FMath::Clamp(StreamingBufferSize, 4, 256);
+	StreamingPlatformMeshes.Reserve(BufferSize);
+	StreamingPlatformTransforms.SetNum(BufferSize);
+
+	for (int32 i = 0; i < BufferSize; i++)
+	{
+		FString MeshName = FString::Printf(TEXT("StreamedPlatform_%d"), i);
+		UProceduralMeshComponent* PlatformMesh = NewObject<UProceduralMeshComponent>(this, *MeshName, RF_Transient);
+		PlatformMesh->SetupAttachment(RootComponent);
+		PlatformMesh->RegisterComponent();
+
+		// Size variation is applied through the component scale, so the geometry is built only once
+		CreatePlatformGeometry(PlatformMesh, PlatformWidth, PlatformDepth, PlatformThickness);
+		PlatformMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+
+		// Unused until first placed
+		PlatformMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		PlatformMesh->SetVisibility(false);
+
+		StreamingPlatformMeshes.Add(PlatformMesh);
+	}
+
+	StreamingRandom.Initialize(RandomSeed != 0 ? RandomSeed : FMath::Rand());
+	StreamingHead = 0;
+	StreamingFirstSequence = 0;
+
+	// The route starts at the first spline point, heading along the spline
+	const FVector StartLocation = PathSpline->GetLocationAtSplinePoint(0, ESplineCoordinateSpace::World);
+	StreamingHeading = PathSpline->GetDirectionAtSplinePoint(0, ESplineCoordinateSpace::World).Rotation().Yaw;
+
+	StreamingPlatformTransforms[0] = FTransform(FRotator(0, StreamingHeading, 0), StartLocation);
+	PlaceStreamedPlatform(StreamingPlatformMeshes[0], StreamingPlatformTransforms[0]);
+	StreamingCount = 1;
+	StreamedPlatformCount = 1;
+
+	UpdateStreaming();
+	SetActorTickEnabled(true);
+}
+
+void AParkourPath::StopStreaming()
+{
+	SetActorTickEnabled(false);
+}
+
+void AParkourPath::UpdateStreaming()
+{
+	const int32 BufferSize = StreamingPlatformMeshes.Num();
+	if (BufferSize == 0 || StreamingCount == 0)
+	{
+		return;
+	}
+
+	AActor* Target = StreamingTarget;
+	if (!Target && GetWorld())
+	{
+		APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+		Target = PlayerController ? PlayerController->GetPawn() : nullptr;
+	}
+
+	if (!Target)
+	{
+		return;
+	}
+
+	const FVector TargetLocation = Target->GetActorLocation();
+
+	// Platform the target is closest to, the ones more than one behind it can be recycled
+	int32 NearestOffset = 0;
+	float NearestDistSq = MAX_flt;
+	for (int32 i = 0; i < StreamingCount; i++)
+	{
+		const float DistSq = FVector::DistSquared(StreamingPlatformTransforms[(StreamingHead + i) % BufferSize].GetLocation(), TargetLocation);
+		if (DistSq < NearestDistSq)
+		{
+			NearestDistSq = DistSq;
+			NearestOffset = i;
+		}
+	}
+
+	// At most one buffer worth per tick, so a teleporting target cannot stall a frame
+	for (int32 Step = 0; Step < BufferSize; Step++)
+	{
+		const FTransform& Newest = StreamingPlatformTransforms[(StreamingHead + StreamingCount - 1) % BufferSize];
+		if (FVector::Dist(Newest.GetLocation(), TargetLocation) >= StreamingLookAhead)
+		{
+			break;
+		}
+
+		if (StreamingCount == BufferSize)
+		{
+			// Buffer full, the oldest platform is only reused once the target has left it behind
+			if (NearestOffset < 2)
+			{
+				break;
+			}
+
+			StreamingHead = (StreamingHead + 1) % BufferSize;
+			StreamingCount--;
+			StreamingFirstSequence++;
+			NearestOffset--;
+		}
+
+		const FTransform NextTransform = MakeNextStreamedPlatform();
+		const int32 Slot = (StreamingHead + StreamingCount) % BufferSize;
+		StreamingPlatformTransforms[Slot] = NextTransform;
+		PlaceStreamedPlatform(StreamingPlatformMeshes[Slot], NextTransform);
+		StreamingCount++;
+		StreamedPlatformCount++;
+	}
+}
+
+FTransform AParkourPath::MakeNextStreamedPlatform()
+{
+	const int32 BufferSize = StreamingPlatformMeshes.Num();
+	const FVector LastPosition = StreamingPlatformTransforms[(StreamingHead + StreamingCount - 1) % BufferSize].GetLocation();
+	const float SafeJumpDist = GetSafeJumpDistance();
+
+	StreamingHeading += StreamingRandom.FRandRange(-StreamingMaxTurnAngle, StreamingMaxTurnAngle);
+	const FVector Direction = FRotator(0, StreamingHeading, 0).Vector();
+
+	// Same distance variation as along a spline, but never beyond the safe jump distance
+	float NextJumpDist = SafeJumpDist;
+	if (bAllowPlatformVariation)
+	{
+		float Variation = StreamingRandom.FRandRange(-PlatformSizeVariation, PlatformSizeVariation);
+		NextJumpDist = FMath::Clamp(SafeJumpDist * (1.0f + Variation), SafeJumpDist * 0.5f, SafeJumpDist);
+	}
+
+	float HeightChange = StreamingRandom.FRandRange(-1.0f, 1.0f) * GetSafeJumpHeight() * StreamingHeightVariation;
+
+	// A reachability table may not allow every distance and height pair, shorten and flatten the jump until it does
+	FVector NextLocation = LastPosition + Direction * NextJumpDist + FVector(0, 0, HeightChange);
+	for (int32 Attempt = 0; Attempt < 4 && !IsJumpValid(LastPosition, NextLocation); Attempt++)
+	{
+		NextJumpDist = FMath::Max(NextJumpDist * 0.75f, SafeJumpDist * 0.25f);
+		HeightChange *= 0.5f;
+		NextLocation = LastPosition + Direction * NextJumpDist + FVector(0, 0, HeightChange);
+	}
+	if (!IsJumpValid(LastPosition, NextLocation))
+	{
+		NextLocation = LastPosition + Direction * SafeJumpDist * 0.25f;
+	}
+
+	FTransform NextTransform;
+	NextTransform.SetLocation(NextLocation);
+	NextTransform.SetRotation(Direction.ToOrientationQuat());
+
+	if (bAllowPlatformVariation)
+	{
+		float ScaleVariation = 1.0f + StreamingRandom.FRandRange(-PlatformSizeVariation * 0.5f, PlatformSizeVariation * 0.5f);
+		NextTransform.SetScale3D(FVector(ScaleVariation, ScaleVariation, 1.0f));
+	}
+
+	return NextTransform;
+}
+
+void AParkourPath::PlaceStreamedPlatform(UProceduralMeshComponent* PlatformMesh, const FTransform& PlatformTransform) const
+{
+	FVector Location = PlatformTransform.GetLocation();
+	Location.Z -= PlatformThickness * 0.5f; // Offset so top of platform is at the route height
+
+	PlatformMesh->SetWorldTransform(FTransform(PlatformTransform.GetRotation(), Location, PlatformTransform.GetScale3D()));
+
+	if (!PlatformMesh->IsVisible())
+	{
+		PlatformMesh->SetVisibility(true);
+		PlatformMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	}
+}
+
+void AParkourPath::DestroyStreamingBuffer()
+{
+	for (UProceduralMeshComponent* Mesh : StreamingPlatformMeshes)
+	{
+		if (Mesh)
+		{
+			Mesh->DestroyComponent();
+		}
+	}
+	StreamingPlatformMeshes.Empty();
+	StreamingPlatformTransforms.Empty();
+	StreamingHead = 0;
+	StreamingCount = 0;
+	StreamingFirstSequence = 0;
+	StreamedPlatformCount = 0;
+
+	SetActorTickEnabled(false);
+}
+
+#if WITH_EDITOR
+void AParkourPath::BakeToStaticMesh()
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_MeshData);
+
+	if (GeneratedPlatformMeshes.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Nothing to bake on %s, generate parkour first"), *GetName());
+		return;
+	}
+
+	const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+	const FTransform Pivot = GetActorTransform();
+
+	// All platforms of the path are merged into a single asset
+	UStaticMesh* BakedMesh = FParkourMeshBaker::BakeToStaticMesh(
+		GeneratedPlatformMeshes,
+		Pivot,
+		Settings->BakedAssetPath,
+		FParkourMeshBaker::MakeAssetName(this, TEXT("Platforms"))
+	);
+
+	if (!BakedMesh)
+	{
+		return;
+	}
+
+	// Swap the procedural platforms for the baked static mesh, keep the transforms for validation
+	for (UStaticMeshComponent* Mesh : BakedPlatformMeshes)
+	{
+		if (Mesh)
+		{
+			Mesh->DestroyComponent();
+		}
+	}
+	BakedPlatformMeshes.Empty();
+
 	for (UProceduralMeshComponent* Mesh : GeneratedPlatformMeshes)
 	{
 		if (Mesh)
@@ -380,22 +1264,138 @@ void AParkourPath::ClearGeneratedParkour()
 		}
 	}
 	GeneratedPlatformMeshes.Empty();
-	GeneratedPlatformTransforms.Empty();
+
+	UStaticMeshComponent* BakedComponent = FParkourMeshBaker::CreateBakedComponent(this, BakedMesh, Pivot, TEXT("BakedPlatforms"));
+	if (BakedComponent)
+	{
+		BakedPlatformMeshes.Add(BakedComponent);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Baked %d parkour platforms into %s"), GeneratedPlatformTransforms.Num(), *BakedMesh->GetPathName());
+}
+#endif
+
+void AParkourPath::RequestPreviewUpdate()
+{
+#if WITH_EDITOR
+	const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+	const float Debounce = Settings ? Settings->PreviewDebounceSeconds : 0.0f;
+	const double Now = FPlatformTime::Seconds();
+
+	// Spline point drags come in as unspecified changes, a quick succession of them is a drag as well
+	const bool bDragging = PreviewChangeType == EPropertyChangeType::Interactive
+		|| (PreviewChangeType != EPropertyChangeType::ValueSet && Now - LastPreviewRequestTime < Debounce);
+	LastPreviewRequestTime = Now;
+
+	if (bDragging && Debounce > 0.0f && GEditor)
+	{
+		UpdateCoarsePreview();
+		GEditor->GetTimerManager()->SetTimer(PreviewDebounceTimer, FTimerDelegate::CreateUObject(this, &AParkourPath::UpdatePreview), Debounce, false);
+		return;
+	}
+
+	if (GEditor)
+	{
+		GEditor->GetTimerManager()->ClearTimer(PreviewDebounceTimer);
+	}
+#endif
+
+	UpdatePreview();
+}
+
+void AParkourPath::UpdateCoarsePreview()
+{
+#if WITH_EDITOR
+	LLM_SCOPE_BYTAG(ParkourGenerator_Preview);
+
+	if (!PreviewComponent || !bShowPlatformPreview || !PathSpline || PathSpline->GetNumberOfSplinePoints() < 2)
+	{
+		UpdatePreview();
+		return;
+	}
+
+	// Path samples: the spline linearized to within 10cm
+	TArray<FVector> PathPoints;
+	PathSpline->ConvertSplineToPolyLine(ESplineCoordinateSpace::World, 100.0f, PathPoints);
+
+	// Platform markers where the greedy solve would try them first, unvalidated
+	const float SplineLength = PathSpline->GetSplineLength();
+	const float MarkerSpacing = FMath::Max(GetSafeJumpDistance(), 1.0f);
+	TArray<FVector> Markers;
+	for (float Distance = 0.0f; Distance < SplineLength + MarkerSpacing && Markers.Num() < MaxPlatforms; Distance += MarkerSpacing)
+	{
+		Markers.Add(PathSpline->GetLocationAtDistanceAlongSpline(FMath::Min(Distance, SplineLength), ESplineCoordinateSpace::World));
+	}
+
+	// Coarse hashes are kept apart from full ones, so the full preview always rebuilds after a drag
+	uint32 PreviewHash = FCrc::MemCrc32(PathPoints.GetData(), PathPoints.Num() * sizeof(FVector), 0xC0A25E);
+	PreviewHash = FCrc::MemCrc32(Markers.GetData(), Markers.Num() * sizeof(FVector), PreviewHash);
+
+	if (!PreviewComponent->BeginPreview(PreviewHash))
+	{
+		return;
+	}
+
+	for (int32 i = 1; i < PathPoints.Num(); i++)
+	{
+		PreviewComponent->AddLine(PathPoints[i - 1], PathPoints[i], FColor::Yellow, 1.0f);
+	}
+
+	const FVector MarkerExtent(PlatformDepth * 0.5f, PlatformWidth * 0.5f, 0.0f);
+	for (const FVector& Marker : Markers)
+	{
+		PreviewComponent->AddBox(Marker, MarkerExtent, FQuat::Identity, FColor::Cyan, 1.0f);
+	}
+
+	PreviewComponent->CommitPreview();
+#endif
 }
 
 void AParkourPath::UpdatePreview()
 {
 #if WITH_EDITOR
-	// Draw debug visualization of platform positions
-	if (!GetWorld())
+	LLM_SCOPE_BYTAG(ParkourGenerator_Preview);
+
+	if (!PreviewComponent)
+	{
+		return;
+	}
+
+	if (!bShowPlatformPreview)
 	{
+		PreviewComponent->ClearPreview();
 		return;
 	}
 
 	// Calculate positions but don't create meshes
-	TArray<FTransform> PreviewTransforms = CalculatePlatformPositions();
+	TArray<bool> PreviewOnRooftop;
+	TArray<FTransform> PreviewTransforms = SolvePlatforms(RandomSeed != 0 ? RandomSeed : FMath::Rand(), PreviewOnRooftop);
+	PreviewJumpValidation.Update(*this, PreviewTransforms);
 
-	// Draw debug boxes and jump arcs
+	// The preview geometry is only rebuilt when the solve or the way it is drawn changed
+	const FVector4 DrawSettings(PlatformWidth, PlatformDepth, PlatformThickness, bShowJumpArcs ? GetSafeJumpHeight() : -1.0f);
+	uint32 PreviewHash = FCrc::MemCrc32(&DrawSettings, sizeof(FVector4));
+	for (int32 i = 0; i < PreviewTransforms.Num(); i++)
+	{
+		const FQuat Rotation = PreviewTransforms[i].GetRotation();
+		const FVector4 Values[3] =
+		{
+			FVector4(PreviewTransforms[i].GetLocation(), PreviewOnRooftop[i] ? 1.0f : 0.0f),
+			FVector4(Rotation.X, Rotation.Y, Rotation.Z, Rotation.W),
+			FVector4(PreviewTransforms[i].GetScale3D(), 0.0f)
+		};
+		PreviewHash = FCrc::MemCrc32(Values, sizeof(Values), PreviewHash);
+	}
+
+	const TArray<int32>& InvalidJumps = PreviewJumpValidation.GetInvalidJumps();
+	PreviewHash = FCrc::MemCrc32(InvalidJumps.GetData(), InvalidJumps.Num() * sizeof(int32), PreviewHash);
+
+	if (!PreviewComponent->BeginPreview(PreviewHash))
+	{
+		return;
+	}
+
+	// Platform boxes, jump arcs and platform numbers
 	for (int32 i = 0; i < PreviewTransforms.Num(); i++)
 	{
 		const FTransform& CurrentTransform = PreviewTransforms[i];
@@ -405,35 +1405,45 @@ void AParkourPath::UpdatePreview()
 		float Width = PlatformWidth * CurrentTransform.GetScale3D().X;
 		float Depth = PlatformDepth * CurrentTransform.GetScale3D().Y;
 
-		DrawDebugBox(
-			GetWorld(),
+		PreviewComponent->AddBox(
 			Location - FVector(0, 0, PlatformThickness * 0.5f),
 			FVector(Depth * 0.5f, Width * 0.5f, PlatformThickness * 0.5f),
 			CurrentTransform.GetRotation(),
-			FColor::Cyan,
-			false,
-			-1.0f,
-			0,
+			PreviewOnRooftop[i] ? FColor::Green : FColor::Cyan,
 			2.0f
 		);
 
-		// Draw jump arcs to next platform
+		// Draw jump arcs to next platform, jumps that fail validation in red even without arcs
+		const bool bJumpValid = i >= PreviewJumpValidation.NumJumps() || PreviewJumpValidation.IsJumpValid(i);
+		if (!bJumpValid && !bShowJumpArcs)
+		{
+			PreviewComponent->AddLine(Location, PreviewTransforms[i + 1].GetLocation(), FColor::Red, 3.0f);
+		}
+
 		if (bShowJumpArcs && i < PreviewTransforms.Num() - 1)
 		{
 			const FTransform& NextTransform = PreviewTransforms[i + 1];
 			FVector NextLocation = NextTransform.GetLocation();
 
-			// Draw arc
-			FVector MidPoint = (Location + NextLocation) * 0.5f;
-			MidPoint.Z += GetSafeJumpHeight() * 0.5f; // Arc peak
+			// Parabola peaking half the safe jump height above the midpoint
+			const int32 ArcSegments = 8;
+			const float ArcPeak = GetSafeJumpHeight() * 0.5f;
+			FVector ArcStart = Location;
+			for (int32 Segment = 1; Segment <= ArcSegments; Segment++)
+			{
+				const float Alpha = (float)Segment / ArcSegments;
+				FVector ArcEnd = FMath::Lerp(Location, NextLocation, Alpha);
+				ArcEnd.Z += 4.0f * ArcPeak * Alpha * (1.0f - Alpha);
 
-			// Draw simple line for now (could be improved to parabola)
-			DrawDebugLine(GetWorld(), Location, MidPoint, FColor::Yellow, false, -1.0f, 0, 1.0f);
-			DrawDebugLine(GetWorld(), MidPoint, NextLocation, FColor::Yellow, false, -1.0f, 0, 1.0f);
+				PreviewComponent->AddLine(ArcStart, ArcEnd, bJumpValid ? FColor::Yellow : FColor::Red, bJumpValid ? 1.0f : 3.0f);
+				ArcStart = ArcEnd;
+			}
 		}
 
 		// Draw platform number
-		DrawDebugString(GetWorld(), Location + FVector(0, 0, 50), FString::Printf(TEXT("%d"), i), nullptr, FColor::White, -1.0f);
+		PreviewComponent->AddLabel(Location + FVector(0, 0, 50), i, FColor::White);
 	}
+
+	PreviewComponent->CommitPreview();
 #endif
 }
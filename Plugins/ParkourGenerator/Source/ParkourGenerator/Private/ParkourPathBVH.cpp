@@ -0,0 +1,240 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourPathBVH.h"
+#include "Components/SplineComponent.h"
+#include "Algo/Sort.h"
+
+namespace ParkourPathBVH
+{
+	static constexpr int32 MaxLeafSegments = 4;
+
+	/** Whether a 2D segment crosses a box (slab clipping) */
+	static bool SegmentIntersectsBox(const FVector2D& Start, const FVector2D& End, const FBox2D& Box)
+	{
+		const FVector2D Dir = End - Start;
+		float TMin = 0.0f;
+		float TMax = 1.0f;
+
+		for (int32 Axis = 0; Axis < 2; Axis++)
+		{
+			if (FMath::Abs(Dir[Axis]) < KINDA_SMALL_NUMBER)
+			{
+				if (Start[Axis] < Box.Min[Axis] || Start[Axis] > Box.Max[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			float TA = (Box.Min[Axis] - Start[Axis]) / Dir[Axis];
+			float TB = (Box.Max[Axis] - Start[Axis]) / Dir[Axis];
+			if (TA > TB)
+			{
+				Swap(TA, TB);
+			}
+
+			TMin = FMath::Max(TMin, TA);
+			TMax = FMath::Min(TMax, TB);
+			if (TMin > TMax)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Squared distance between a 2D segment and a box, exact */
+	static float SegmentBoxDistanceSquared(const FVector2D& Start, const FVector2D& End, const FBox2D& Box)
+	{
+		if (SegmentIntersectsBox(Start, End, Box))
+		{
+			return 0.0f;
+		}
+
+		// Apart, so the closest pair involves an end point or a box corner
+		float DistSq = FMath::Min(Box.ComputeSquaredDistanceToPoint(Start), Box.ComputeSquaredDistanceToPoint(End));
+
+		const FVector2D Corners[4] = {Box.Min, FVector2D(Box.Max.X, Box.Min.Y), Box.Max, FVector2D(Box.Min.X, Box.Max.Y)};
+		for (const FVector2D& Corner : Corners)
+		{
+			DistSq = FMath::Min(DistSq, (float)FVector2D::DistSquared(Corner, FMath::ClosestPointOnSegment2D(Corner, Start, End)));
+		}
+
+		return DistSq;
+	}
+
+	/** Squared XY distance between two boxes */
+	static float BoxDistanceSquared2D(const FBox& Node, const FBox2D& Box)
+	{
+		const float DX = FMath::Max3(0.0f, (float)(Node.Min.X - Box.Max.X), (float)(Box.Min.X - Node.Max.X));
+		const float DY = FMath::Max3(0.0f, (float)(Node.Min.Y - Box.Max.Y), (float)(Box.Min.Y - Node.Max.Y));
+		return DX * DX + DY * DY;
+	}
+}
+
+void FParkourPathBVH::Build(const USplineComponent& Spline, float Tolerance, float MaxSegmentLength)
+{
+	TArray<FVector> PolyLine;
+	Spline.ConvertSplineToPolyLine(ESplineCoordinateSpace::World, FMath::Square(FMath::Max(Tolerance, 0.1f)), PolyLine);
+	Build(PolyLine, MaxSegmentLength);
+}
+
+void FParkourPathBVH::Build(const TArray<FVector>& InPoints, float MaxSegmentLength)
+{
+	Points = InPoints;
+	Segments.Reset();
+	Nodes.Reset();
+
+	const float SegmentLength = FMath::Max(MaxSegmentLength, 1.0f);
+	for (int32 i = 1; i < Points.Num(); i++)
+	{
+		const int32 NumPieces = FMath::Max(FMath::CeilToInt(FVector::Dist(Points[i - 1], Points[i]) / SegmentLength), 1);
+		for (int32 Piece = 0; Piece < NumPieces; Piece++)
+		{
+			Segments.Add({
+				FMath::Lerp(Points[i - 1], Points[i], (float)Piece / NumPieces),
+				FMath::Lerp(Points[i - 1], Points[i], (float)(Piece + 1) / NumPieces)
+			});
+		}
+	}
+
+	if (Segments.Num() == 0)
+	{
+		return;
+	}
+
+	Nodes.Reserve(2 * Segments.Num() / ParkourPathBVH::MaxLeafSegments + 1);
+	Nodes.AddDefaulted();
+	BuildNode(0, 0, Segments.Num());
+}
+
+void FParkourPathBVH::BuildNode(int32 NodeIndex, int32 First, int32 Num)
+{
+	FBox Bounds(ForceInit);
+	FBox Centers(ForceInit);
+	for (int32 i = First; i < First + Num; i++)
+	{
+		Bounds += Segments[i].Start;
+		Bounds += Segments[i].End;
+		Centers += (Segments[i].Start + Segments[i].End) * 0.5f;
+	}
+
+	Nodes[NodeIndex].Bounds = Bounds;
+
+	if (Num <= ParkourPathBVH::MaxLeafSegments)
+	{
+		Nodes[NodeIndex].First = First;
+		Nodes[NodeIndex].NumSegments = Num;
+		return;
+	}
+
+	// Median split along the axis the segment centers spread most on
+	const FVector Extent = Centers.GetExtent();
+	const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+	Algo::SortBy(TArrayView<FSegment>(Segments.GetData() + First, Num), [Axis](const FSegment& Segment)
+	{
+		return Segment.Start[Axis] + Segment.End[Axis];
+	});
+
+	// Nodes may reallocate below, only indices are kept
+	const int32 Children = Nodes.AddDefaulted(2);
+	Nodes[NodeIndex].First = Children;
+	Nodes[NodeIndex].NumSegments = 0;
+
+	const int32 NumLeft = Num / 2;
+	BuildNode(Children, First, NumLeft);
+	BuildNode(Children + 1, First + NumLeft, Num - NumLeft);
+}
+
+float FParkourPathBVH::GetDistance(const FVector& Point, FVector* OutClosestPoint) const
+{
+	if (IsEmpty())
+	{
+		return MAX_flt;
+	}
+
+	float BestDistSq = MAX_flt;
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(false)];
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(Point) >= BestDistSq)
+		{
+			continue;
+		}
+
+		if (Node.NumSegments > 0)
+		{
+			for (int32 i = Node.First; i < Node.First + Node.NumSegments; i++)
+			{
+				const FVector Closest = FMath::ClosestPointOnSegment(Point, Segments[i].Start, Segments[i].End);
+				const float DistSq = FVector::DistSquared(Closest, Point);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					if (OutClosestPoint)
+					{
+						*OutClosestPoint = Closest;
+					}
+				}
+			}
+			continue;
+		}
+
+		// Visit the nearer child first, it tightens the bound for the other one
+		const bool bLeftNearer = Nodes[Node.First].Bounds.ComputeSquaredDistanceToPoint(Point) <= Nodes[Node.First + 1].Bounds.ComputeSquaredDistanceToPoint(Point);
+		Stack.Add(bLeftNearer ? Node.First + 1 : Node.First);
+		Stack.Add(bLeftNearer ? Node.First : Node.First + 1);
+	}
+
+	return FMath::Sqrt(BestDistSq);
+}
+
+bool FParkourPathBVH::OverlapsFootprint(const FBox2D& Footprint, float Clearance, float BelowHeight) const
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+
+	const float ClearanceSq = FMath::Square(Clearance);
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(false)];
+		if (Node.Bounds.Min.Z >= BelowHeight || ParkourPathBVH::BoxDistanceSquared2D(Node.Bounds, Footprint) > ClearanceSq)
+		{
+			continue;
+		}
+
+		if (Node.NumSegments == 0)
+		{
+			Stack.Add(Node.First);
+			Stack.Add(Node.First + 1);
+			continue;
+		}
+
+		for (int32 i = Node.First; i < Node.First + Node.NumSegments; i++)
+		{
+			const FSegment& Segment = Segments[i];
+			if (FMath::Min(Segment.Start.Z, Segment.End.Z) >= BelowHeight)
+			{
+				continue;
+			}
+
+			const FVector2D Start(Segment.Start.X, Segment.Start.Y);
+			const FVector2D End(Segment.End.X, Segment.End.Y);
+			if (ParkourPathBVH::SegmentBoxDistanceSquared(Start, End, Footprint) <= ClearanceSq)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
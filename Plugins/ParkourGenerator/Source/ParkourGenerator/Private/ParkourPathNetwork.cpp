@@ -0,0 +1,318 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourPathNetwork.h"
+#include "ParkourPath.h"
+#include "Components/SplineComponent.h"
+#include "ParkourLLM.h"
+#include "ParkourNavigationBatch.h"
+#include "Async/ParallelFor.h"
+
+AParkourPathNetwork::AParkourPathNetwork()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	USceneComponent* Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	SetRootComponent(Root);
+}
+
+bool AParkourPathNetwork::IsBranchValid(int32 BranchIndex) const
+{
+	const AParkourPath* Branch = Branches[BranchIndex];
+	return Branch && Branch->PathSpline && Branch->PathSpline->GetNumberOfSplinePoints() >= 2;
+}
+
+bool AParkourPathNetwork::UsesRooftops() const
+{
+	for (const AParkourPath* Branch : Branches)
+	{
+		if (Branch && Branch->bUseBuildingRooftops && Branch->RooftopSourceArea)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void AParkourPathNetwork::GenerateNetwork()
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_PathSolve);
+
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	FParkourGenerationReport Report;
+	const double StartTime = Report.Start();
+	Report.Name = GetName();
+
+	FindJunctions();
+
+	// Branches without their own seed get one derived from the network seed
+	const int32 BaseSeed = NetworkSeed != 0 ? NetworkSeed : FMath::Rand();
+	TArray<int32> Seeds;
+	Seeds.SetNum(Branches.Num());
+	for (int32 i = 0; i < Branches.Num(); i++)
+	{
+		Seeds[i] = Branches[i] && Branches[i]->RandomSeed != 0 ? Branches[i]->RandomSeed : (int32)HashCombine(GetTypeHash(BaseSeed), GetTypeHash(i));
+	}
+
+	// Branches are independent until their junctions are reconciled
+	TArray<TArray<FTransform>> Platforms;
+	TArray<TArray<bool>> OnRooftop;
+	Platforms.SetNum(Branches.Num());
+	OnRooftop.SetNum(Branches.Num());
+
+	const double SolveStart = FPlatformTime::Seconds();
+	FParkourSolveStats Stats;
+	ParallelFor(Branches.Num(), [&](int32 BranchIndex)
+	{
+		if (IsBranchValid(BranchIndex))
+		{
+			Platforms[BranchIndex] = Branches[BranchIndex]->SolvePlatforms(Seeds[BranchIndex], OnRooftop[BranchIndex], &Stats);
+		}
+	});
+
+	ReconcileJunctions(Platforms, OnRooftop);
+	Report.SolveTimeMs = FParkourGenerationReport::MillisecondsSince(SolveStart);
+	Report.AddSolveStats(Stats);
+
+	const double MeshStart = FPlatformTime::Seconds();
+	for (int32 i = 0; i < Branches.Num(); i++)
+	{
+		if (IsBranchValid(i))
+		{
+			Branches[i]->ApplyPlatformLayout(Platforms[i], Seeds[i], OnRooftop[i]);
+			Report.Platforms += Platforms[i].Num();
+			Report.AddMeshes(Branches[i]->GeneratedPlatformMeshes);
+		}
+	}
+	Report.MeshTimeMs = FParkourGenerationReport::MillisecondsSince(MeshStart);
+
+	Report.Seed = BaseSeed;
+	Report.Finish(StartTime);
+	LastGenerationReport = Report;
+
+	UE_LOG(LogTemp, Log, TEXT("Generated parkour network with %d branches, %d junctions and %d platforms"), Branches.Num(), Junctions.Num(), Report.Platforms);
+}
+
+void AParkourPathNetwork::ClearNetwork()
+{
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	for (AParkourPath* Branch : Branches)
+	{
+		if (Branch)
+		{
+			Branch->ClearGeneratedParkour();
+		}
+	}
+
+	Junctions.Empty();
+	JunctionEnds.Empty();
+}
+
+void AParkourPathNetwork::FindJunctions()
+{
+	Junctions.Reset();
+	JunctionEnds.Reset();
+
+	// Open branches contribute their start and end
+	TArray<int32> Ends;
+	TArray<FVector> EndLocations;
+	for (int32 i = 0; i < Branches.Num(); i++)
+	{
+		if (!IsBranchValid(i) || Branches[i]->PathSpline->IsClosedLoop())
+		{
+			continue;
+		}
+
+		const USplineComponent* Spline = Branches[i]->PathSpline;
+		Ends.Add(i * 2);
+		EndLocations.Add(Spline->GetLocationAtSplinePoint(0, ESplineCoordinateSpace::World));
+		Ends.Add(i * 2 + 1);
+		EndLocations.Add(Spline->GetLocationAtSplinePoint(Spline->GetNumberOfSplinePoints() - 1, ESplineCoordinateSpace::World));
+	}
+
+	// Cluster ends in order, so the same network always gives the same junctions
+	TArray<bool> Clustered;
+	Clustered.Init(false, Ends.Num());
+	for (int32 i = 0; i < Ends.Num(); i++)
+	{
+		if (Clustered[i])
+		{
+			continue;
+		}
+
+		TArray<int32> ClusterEnds = {Ends[i]};
+		FVector Sum = EndLocations[i];
+		Clustered[i] = true;
+
+		for (int32 j = i + 1; j < Ends.Num(); j++)
+		{
+			if (!Clustered[j] && FVector::Dist(EndLocations[i], EndLocations[j]) <= JunctionRadius)
+			{
+				ClusterEnds.Add(Ends[j]);
+				Sum += EndLocations[j];
+				Clustered[j] = true;
+			}
+		}
+
+		FParkourJunction Junction;
+		Junction.Location = Sum / ClusterEnds.Num();
+		Junction.OwnerBranch = ClusterEnds[0] / 2;
+
+		// A lone end joins another branch if it lies on that branch's route, which then owns the junction
+		if (ClusterEnds.Num() == 1)
+		{
+			const int32 EndBranch = ClusterEnds[0] / 2;
+			Junction.OwnerBranch = INDEX_NONE;
+
+			for (int32 Host = 0; Host < Branches.Num(); Host++)
+			{
+				if (Host == EndBranch || !IsBranchValid(Host))
+				{
+					continue;
+				}
+
+				const FVector OnRoute = Branches[Host]->PathSpline->FindLocationClosestToWorldLocation(EndLocations[i], ESplineCoordinateSpace::World);
+				if (FVector::Dist(OnRoute, EndLocations[i]) <= JunctionRadius)
+				{
+					Junction.Location = OnRoute;
+					Junction.OwnerBranch = Host;
+					break;
+				}
+			}
+
+			// A dead end, not a junction
+			if (Junction.OwnerBranch == INDEX_NONE)
+			{
+				continue;
+			}
+		}
+
+		for (int32 End : ClusterEnds)
+		{
+			Junction.Branches.AddUnique(End / 2);
+		}
+		Junction.Branches.AddUnique(Junction.OwnerBranch);
+
+		Junctions.Add(Junction);
+		JunctionEnds.Add(ClusterEnds);
+	}
+}
+
+void AParkourPathNetwork::ReconcileJunctions(TArray<TArray<FTransform>>& Platforms, TArray<TArray<bool>>& OnRooftop) const
+{
+	// Ends whose platform is replaced by the junction platform of another branch
+	TArray<int32> DroppedEnds;
+
+	for (int32 JunctionIndex = 0; JunctionIndex < Junctions.Num(); JunctionIndex++)
+	{
+		const FParkourJunction& Junction = Junctions[JunctionIndex];
+		const TArray<int32>& Ends = JunctionEnds[JunctionIndex];
+		TArray<FTransform>& OwnerPlatforms = Platforms[Junction.OwnerBranch];
+		if (OwnerPlatforms.Num() == 0)
+		{
+			continue;
+		}
+
+		FVector JunctionLocation = Junction.Location;
+
+		if (Ends[0] / 2 == Junction.OwnerBranch)
+		{
+			// Branches meeting end to end: the first one's end platform moves onto the junction
+			const int32 PlatformIndex = Ends[0] % 2 == 0 ? 0 : OwnerPlatforms.Num() - 1;
+			OwnerPlatforms[PlatformIndex].SetLocation(JunctionLocation);
+			OnRooftop[Junction.OwnerBranch][PlatformIndex] = false;
+			DroppedEnds.Append(&Ends[1], Ends.Num() - 1);
+		}
+		else
+		{
+			// A branch joining another's route: the closest platform of the route is the junction
+			float BestDistSq = MAX_flt;
+			for (const FTransform& Platform : OwnerPlatforms)
+			{
+				const float DistSq = FVector::DistSquared(Platform.GetLocation(), Junction.Location);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					JunctionLocation = Platform.GetLocation();
+				}
+			}
+			DroppedEnds.Append(Ends);
+		}
+
+		// Branches whose end platform is dropped now jump from or to the junction platform
+		for (int32 End : Ends)
+		{
+			const int32 Branch = End / 2;
+			const TArray<FTransform>& BranchPlatforms = Platforms[Branch];
+			if (BranchPlatforms.Num() < 2)
+			{
+				continue;
+			}
+
+			const bool bStart = End % 2 == 0;
+			const FVector Neighbour = BranchPlatforms[bStart ? 1 : BranchPlatforms.Num() - 2].GetLocation();
+			const FVector From = bStart ? JunctionLocation : Neighbour;
+			const FVector To = bStart ? Neighbour : JunctionLocation;
+			if (Branches[Branch]->IsJumpValid(From, To))
+			{
+				continue;
+			}
+
+			// Bridge platforms go between the end platform and its neighbour, so the end stays first or last
+			TArray<FTransform> Bridge;
+			if (!MakeBridge(*Branches[Branch], From, To, Bridge))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Junction %d of %s cannot be reached from %s, move the spline ends closer"),
+					JunctionIndex, *GetName(), *Branches[Branch]->GetName());
+				continue;
+			}
+
+			const int32 InsertIndex = bStart ? 1 : Platforms[Branch].Num() - 1;
+			Platforms[Branch].Insert(Bridge, InsertIndex);
+			for (int32 i = 0; i < Bridge.Num(); i++)
+			{
+				OnRooftop[Branch].Insert(false, InsertIndex);
+			}
+		}
+	}
+
+	// Drop ends after all moves, so platform indices above stay valid. Removing the start keeps the end last
+	for (int32 End : DroppedEnds)
+	{
+		const int32 Branch = End / 2;
+		if (Platforms[Branch].Num() < 2)
+		{
+			continue;
+		}
+
+		const int32 PlatformIndex = End % 2 == 0 ? 0 : Platforms[Branch].Num() - 1;
+		Platforms[Branch].RemoveAt(PlatformIndex);
+		OnRooftop[Branch].RemoveAt(PlatformIndex);
+	}
+}
+
+bool AParkourPathNetwork::MakeBridge(const AParkourPath& Branch, const FVector& From, const FVector& To, TArray<FTransform>& OutBridge)
+{
+	OutBridge.Reset();
+
+	// Every added platform shortens and flattens all jumps of the bridge equally
+	const FVector Diff = To - From;
+	const int32 MaxBridgePlatforms = FMath::Max(Branch.MaxPlatforms, 1);
+	int32 NumPlatforms = 1;
+	while (!Branch.IsJumpValid(From, From + Diff / (NumPlatforms + 1)))
+	{
+		if (++NumPlatforms > MaxBridgePlatforms)
+		{
+			return false;
+		}
+	}
+
+	const FQuat Rotation = FRotator(0.0f, Diff.Rotation().Yaw, 0.0f).Quaternion();
+	for (int32 i = 1; i <= NumPlatforms; i++)
+	{
+		OutBridge.Add(FTransform(Rotation, From + Diff * ((float)i / (NumPlatforms + 1))));
+	}
+
+	return true;
+}
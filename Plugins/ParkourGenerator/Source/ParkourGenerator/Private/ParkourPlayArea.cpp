@@ -3,9 +3,19 @@
 #include "ParkourPlayArea.h"
 #include "ParkourPath.h"
 #include "ProceduralMeshComponent.h"
-#include "DrawDebugHelpers.h"
+#include "Components/StaticMeshComponent.h"
+#include "ParkourGeneratorSettings.h"
+#include "ParkourMeshBaker.h"
+#include "ParkourGenerationCache.h"
+#include "ParkourWorldSubsystem.h"
+#include "ParkourPreviewComponent.h"
+#include "ParkourLLM.h"
+#include "ParkourNavigationBatch.h"
 #include "Engine/World.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryWriter.h"
 
 AParkourPlayArea::AParkourPlayArea()
 {
@@ -36,6 +46,13 @@ AParkourPlayArea::AParkourPlayArea()
 	CustomBoundsSpline->AddSplinePoint(FVector(2500, -2500, 0), ESplineCoordinateSpace::Local);
 	CustomBoundsSpline->AddSplinePoint(FVector(2500, 2500, 0), ESplineCoordinateSpace::Local);
 	CustomBoundsSpline->AddSplinePoint(FVector(-2500, 2500, 0), ESplineCoordinateSpace::Local);
+
+	// Create preview component for the L and U shapes (stripped from cooked builds)
+	PreviewComponent = CreateEditorOnlyDefaultSubobject<UParkourPreviewComponent>(TEXT("Preview"));
+	if (PreviewComponent)
+	{
+		PreviewComponent->SetupAttachment(Root);
+	}
 }
 
 void AParkourPlayArea::OnConstruction(const FTransform& Transform)
@@ -44,16 +61,62 @@ void AParkourPlayArea::OnConstruction(const FTransform& Transform)
 	UpdateBoundsVisualization();
 }
 
+void AParkourPlayArea::PostLoad()
+{
+	Super::PostLoad();
+
+	// Building boxes are not saved, restore them from the compact record
+	CompactLayout.GetBuildings(GeneratedBuildingBoxes);
+
+	// Transient meshes come back as null references
+	GeneratedBuildingMeshes.Remove(nullptr);
+	GeneratedFloorMeshes.Remove(nullptr);
+
+	// The single floor quad of older levels is kept as one chunk until the environment is generated again
+	if (GeneratedFloorMesh_DEPRECATED)
+	{
+		GeneratedFloorMeshes.Add(GeneratedFloorMesh_DEPRECATED);
+		GeneratedFloorMesh_DEPRECATED = nullptr;
+	}
+
+	bLayoutRebuildPending = LayoutStorage == EParkourLayoutStorage::CompactLayout
+		&& (GeneratedBuildingBoxes.Num() > 0 || CompactLayout.bFloor)
+		&& GeneratedBuildingMeshes.Num() == 0
+		&& GeneratedFloorMeshes.Num() == 0
+		&& BakedEnvironmentMeshes.Num() == 0;
+}
+
+void AParkourPlayArea::PostRegisterAllComponents()
+{
+	Super::PostRegisterAllComponents();
+
+	if (bLayoutRebuildPending)
+	{
+		bLayoutRebuildPending = false;
+		CreateEnvironmentMeshes();
+
+		UE_LOG(LogTemp, Log, TEXT("Rebuilt %d buildings from compact layout"), GeneratedBuildingBoxes.Num());
+	}
+}
+
 #if WITH_EDITOR
 void AParkourPlayArea::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(AParkourPlayArea, LayoutStorage))
+	{
+		ApplyLayoutStorage();
+	}
+
 	UpdateBoundsVisualization();
 }
 #endif
 
 void AParkourPlayArea::UpdateBoundsVisualization()
 {
+	LLM_SCOPE_BYTAG(ParkourGenerator_Preview);
+
 	// Update box visibility based on shape type
 	bool bUseBox = (AreaShape != EParkourAreaShape::Custom);
 	BoundsBox->SetVisibility(bShowBounds && bUseBox);
@@ -66,8 +129,28 @@ void AParkourPlayArea::UpdateBoundsVisualization()
 	}
 
 #if WITH_EDITOR
-	// Draw additional debug shapes for L and U shapes
-	if (bShowBounds && GetWorld())
+	if (!PreviewComponent)
+	{
+		return;
+	}
+
+	// Draw additional outlines for L and U shapes
+	const bool bMultiBox = AreaShape == EParkourAreaShape::LShape || AreaShape == EParkourAreaShape::UShape;
+	if (!bShowBounds || !bMultiBox)
+	{
+		PreviewComponent->ClearPreview();
+		return;
+	}
+
+	// Only rebuilt when the outline changed
+	const FVector Inputs[3] =
+	{
+		GetActorLocation(),
+		AreaDimensions,
+		FVector(LShapeArmWidth, UShapeArmWidth, (float)AreaShape)
+	};
+
+	if (PreviewComponent->BeginPreview(FCrc::MemCrc32(Inputs, sizeof(Inputs))))
 	{
 		if (AreaShape == EParkourAreaShape::LShape)
 		{
@@ -75,12 +158,12 @@ void AParkourPlayArea::UpdateBoundsVisualization()
 			FVector BaseOrigin = GetActorLocation();
 
 			// Main arm
-			DrawDebugBox(GetWorld(), BaseOrigin, AreaDimensions * 0.5f, FColor::Green, false, -1.0f, 0, 2.0f);
+			PreviewComponent->AddBox(BaseOrigin, AreaDimensions * 0.5f, FQuat::Identity, FColor::Green, 2.0f);
 
 			// Secondary arm
 			FVector SecondArmOrigin = BaseOrigin + FVector(AreaDimensions.X * 0.5f + LShapeArmWidth * 0.5f, 0, 0);
 			FVector SecondArmExtent(LShapeArmWidth * 0.5f, AreaDimensions.Y * 0.5f, AreaDimensions.Z * 0.5f);
-			DrawDebugBox(GetWorld(), SecondArmOrigin, SecondArmExtent, FColor::Green, false, -1.0f, 0, 2.0f);
+			PreviewComponent->AddBox(SecondArmOrigin, SecondArmExtent, FQuat::Identity, FColor::Green, 2.0f);
 		}
 		else if (AreaShape == EParkourAreaShape::UShape)
 		{
@@ -89,17 +172,19 @@ void AParkourPlayArea::UpdateBoundsVisualization()
 
 			// Main corridor
 			FVector MainExtent(AreaDimensions.X * 0.5f, UShapeArmWidth * 0.5f, AreaDimensions.Z * 0.5f);
-			DrawDebugBox(GetWorld(), BaseOrigin, MainExtent, FColor::Green, false, -1.0f, 0, 2.0f);
+			PreviewComponent->AddBox(BaseOrigin, MainExtent, FQuat::Identity, FColor::Green, 2.0f);
 
 			// Left arm
 			FVector LeftArmOrigin = BaseOrigin + FVector(0, -AreaDimensions.Y * 0.25f, 0);
 			FVector ArmExtent(UShapeArmWidth * 0.5f, AreaDimensions.Y * 0.25f, AreaDimensions.Z * 0.5f);
-			DrawDebugBox(GetWorld(), LeftArmOrigin, ArmExtent, FColor::Green, false, -1.0f, 0, 2.0f);
+			PreviewComponent->AddBox(LeftArmOrigin, ArmExtent, FQuat::Identity, FColor::Green, 2.0f);
 
 			// Right arm
 			FVector RightArmOrigin = BaseOrigin + FVector(0, AreaDimensions.Y * 0.25f, 0);
-			DrawDebugBox(GetWorld(), RightArmOrigin, ArmExtent, FColor::Green, false, -1.0f, 0, 2.0f);
+			PreviewComponent->AddBox(RightArmOrigin, ArmExtent, FQuat::Identity, FColor::Green, 2.0f);
 		}
+
+		PreviewComponent->CommitPreview();
 	}
 #endif
 }
@@ -230,38 +315,45 @@ FBox AParkourPlayArea::GetAreaBounds() const
 	return FBox(Min, Max);
 }
 
-bool AParkourPlayArea::IsPlacementValid(const FVector& Location, const FVector& Size) const
+bool AParkourPlayArea::IsPlacementValid(const FVector& Location, const FVector& Size, const TArray<FTransform>& Platforms, FParkourSolveStats* Stats) const
 {
 	// Check if placement overlaps with parkour path
 	if (ParkourPath && ParkourPath->PathSpline)
 	{
-		USplineComponent* Spline = ParkourPath->PathSpline;
-		float SplineLength = Spline->GetSplineLength();
-
-		// Sample spline and check distance
-		for (float Dist = 0; Dist < SplineLength; Dist += 100.0f)
-		{
-			FVector SplinePoint = Spline->GetLocationAtDistanceAlongSpline(Dist, ESplineCoordinateSpace::World);
+		// A path that lands on these rooftops may run over buildings, as long as they stay below it
+		const bool bRooftopRoute = ParkourPath->IsUsingRooftopsOf(this);
 
-			// Check horizontal distance
-			FVector HorizontalDiff = Location - SplinePoint;
-			HorizontalDiff.Z = 0;
+		// Exact distance between the building footprint and the path segments
+		const FBox2D Footprint(
+			FVector2D(Location.X - Size.X * 0.5f, Location.Y - Size.Y * 0.5f),
+			FVector2D(Location.X + Size.X * 0.5f, Location.Y + Size.Y * 0.5f));
 
-			if (HorizontalDiff.Size() < PathClearance + FMath::Max(Size.X, Size.Y) * 0.5f)
+		if (ParkourPath->GetPathBVH().OverlapsFootprint(Footprint, PathClearance, bRooftopRoute ? Location.Z + Size.Z : MAX_flt))
+		{
+			if (Stats)
 			{
-				return false;
+				Stats->RejectedPathClearance++;
 			}
+			return false;
 		}
 
-		// Also check generated platforms
-		for (const FTransform& PlatformTransform : ParkourPath->GeneratedPlatformTransforms)
+		// The platforms of a rooftop route are solved against these buildings later
+		if (bRooftopRoute)
+		{
+			return true;
+		}
+
+		// Also check the platforms
+		for (const FTransform& PlatformTransform : Platforms)
 		{
 			FVector PlatformLoc = PlatformTransform.GetLocation();
-			FVector HorizontalDiff = Location - PlatformLoc;
-			HorizontalDiff.Z = 0;
 
-			if (HorizontalDiff.Size() < PathClearance + FMath::Max(Size.X, Size.Y) * 0.5f)
+			if (Footprint.ComputeSquaredDistanceToPoint(FVector2D(PlatformLoc.X, PlatformLoc.Y)) < FMath::Square(PathClearance))
 			{
+				if (Stats)
+				{
+					Stats->RejectedPlatformClearance++;
+				}
 				return false;
 			}
 		}
@@ -272,8 +364,17 @@ bool AParkourPlayArea::IsPlacementValid(const FVector& Location, const FVector&
 
 UProceduralMeshComponent* AParkourPlayArea::CreateBuildingMesh(const FVector& Location, const FVector& Size, int32 Index)
 {
-	FString MeshName = FString::Printf(TEXT("Building_%d"), Index);
-	UProceduralMeshComponent* BuildingMesh = NewObject<UProceduralMeshComponent>(this, *MeshName);
+	LLM_SCOPE_BYTAG(ParkourGenerator_MeshData);
+
+	FName MeshName(*FString::Printf(TEXT("Building_%d"), Index));
+
+	// Path updates shift the indices, an older building may still hold the name
+	if (StaticFindObjectFast(nullptr, this, MeshName))
+	{
+		MeshName = MakeUniqueObjectName(this, UProceduralMeshComponent::StaticClass(), MeshName);
+	}
+
+	UProceduralMeshComponent* BuildingMesh = NewObject<UProceduralMeshComponent>(this, MeshName, FParkourCompactLayout::GetComponentFlags(LayoutStorage));
 	BuildingMesh->SetupAttachment(RootComponent);
 	BuildingMesh->RegisterComponent();
 
@@ -335,7 +436,7 @@ UProceduralMeshComponent* AParkourPlayArea::CreateBuildingMesh(const FVector& Lo
 		VertexColors[i] = BuildingColor;
 	}
 
-	BuildingMesh->CreateMeshSection(0, Vertices, Triangles, Normals, UVs, VertexColors, TArray<FProcMeshTangent>(), true);
+	ParkourLLM::CreateMeshSection(*BuildingMesh, 0, Vertices, Triangles, Normals, UVs, VertexColors);
 
 	// Set position
 	BuildingMesh->SetWorldLocation(Location);
@@ -347,168 +448,337 @@ UProceduralMeshComponent* AParkourPlayArea::CreateBuildingMesh(const FVector& Lo
 	return BuildingMesh;
 }
 
-void AParkourPlayArea::CreateFloorMesh()
+namespace ParkourPlayArea
 {
-	if (GeneratedFloorMesh)
+	/** Whether a point lies inside a closed polygon (crossing number test) */
+	static bool IsPointInPolygon(const FVector2D& Point, const TArray<FVector2D>& Polygon)
 	{
-		GeneratedFloorMesh->DestroyComponent();
-		GeneratedFloorMesh = nullptr;
+		bool bInside = false;
+		for (int32 i = 0, j = Polygon.Num() - 1; i < Polygon.Num(); j = i++)
+		{
+			const FVector2D& A = Polygon[i];
+			const FVector2D& B = Polygon[j];
+			if ((A.Y > Point.Y) != (B.Y > Point.Y) && Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X)
+			{
+				bInside = !bInside;
+			}
+		}
+		return bInside;
 	}
+}
 
-	GeneratedFloorMesh = NewObject<UProceduralMeshComponent>(this, TEXT("Floor"));
-	GeneratedFloorMesh->SetupAttachment(RootComponent);
-	GeneratedFloorMesh->RegisterComponent();
+void AParkourPlayArea::BuildFloorChunks(TArray<TArray<FBox2D>>& OutChunks) const
+{
+	OutChunks.Reset();
 
-	FVector HalfExtent = AreaDimensions * 0.5f;
+	// The area shape in actor space, as rectangles (same as IsPointInPlayArea) or as the custom spline's polygon
+	const FVector2D HalfExtent(AreaDimensions.X * 0.5f, AreaDimensions.Y * 0.5f);
+	TArray<FBox2D> Rects;
+	TArray<FVector2D> Polygon;
 
-	// Floor vertices
-	TArray<FVector> Vertices;
-	Vertices.Add(FVector(-HalfExtent.X, -HalfExtent.Y, -FloorOffset));
-	Vertices.Add(FVector(HalfExtent.X, -HalfExtent.Y, -FloorOffset));
-	Vertices.Add(FVector(HalfExtent.X, HalfExtent.Y, -FloorOffset));
-	Vertices.Add(FVector(-HalfExtent.X, HalfExtent.Y, -FloorOffset));
+	switch (AreaShape)
+	{
+	case EParkourAreaShape::Box:
+		Rects.Add(FBox2D(-HalfExtent, HalfExtent));
+		break;
+
+	case EParkourAreaShape::LShape:
+		Rects.Add(FBox2D(-HalfExtent, HalfExtent));
+		Rects.Add(FBox2D(FVector2D(HalfExtent.X, -HalfExtent.Y), FVector2D(HalfExtent.X + LShapeArmWidth, HalfExtent.Y)));
+		break;
+
+	case EParkourAreaShape::UShape:
+	{
+		const float HalfArm = UShapeArmWidth * 0.5f;
+		Rects.Add(FBox2D(FVector2D(-HalfExtent.X, -HalfArm), FVector2D(HalfExtent.X, HalfArm)));
+		Rects.Add(FBox2D(FVector2D(-HalfArm, -HalfExtent.Y), FVector2D(HalfArm, -HalfArm)));
+		Rects.Add(FBox2D(FVector2D(-HalfArm, HalfArm), FVector2D(HalfArm, HalfExtent.Y)));
+		break;
+	}
+
+	case EParkourAreaShape::Custom:
+	{
+		TArray<FVector> Points;
+		if (CustomBoundsSpline)
+		{
+			CustomBoundsSpline->ConvertSplineToPolyLine(ESplineCoordinateSpace::World, FMath::Square(10.0f), Points);
+		}
+		for (const FVector& Point : Points)
+		{
+			const FVector LocalPoint = GetActorTransform().InverseTransformPosition(Point);
+			Polygon.Add(FVector2D(LocalPoint.X, LocalPoint.Y));
+		}
+		break;
+	}
+	}
+
+	FBox2D Bounds(ForceInit);
+	for (const FBox2D& Rect : Rects)
+	{
+		Bounds += Rect;
+	}
+	for (const FVector2D& Point : Polygon)
+	{
+		Bounds += Point;
+	}
 
-	TArray<int32> Triangles = {0, 1, 2, 0, 2, 3};
+	if (!Bounds.bIsValid)
+	{
+		return;
+	}
 
-	TArray<FVector> Normals = {FVector::UpVector, FVector::UpVector, FVector::UpVector, FVector::UpVector};
+	const float TileSize = FMath::Max(FloorTileSize, 100.0f);
+	const float ChunkSize = FMath::Max(FloorChunkSize, TileSize);
+	const int32 NumTilesX = FMath::CeilToInt(Bounds.GetSize().X / TileSize);
+	const int32 NumTilesY = FMath::CeilToInt(Bounds.GetSize().Y / TileSize);
 
-	TArray<FVector2D> UVs = {FVector2D(0, 0), FVector2D(1, 0), FVector2D(1, 1), FVector2D(0, 1)};
+	TMap<FIntPoint, int32> ChunkIndices;
+	for (int32 X = 0; X < NumTilesX; X++)
+	{
+		for (int32 Y = 0; Y < NumTilesY; Y++)
+		{
+			const FVector2D TileMin = Bounds.Min + FVector2D(X, Y) * TileSize;
+			const FBox2D Tile(TileMin, TileMin + FVector2D(TileSize, TileSize));
 
+			// Tiles belong to the chunk their center is in
+			const FVector2D Offset = Tile.GetCenter() - Bounds.Min;
+			const FIntPoint ChunkCoord(FMath::FloorToInt(Offset.X / ChunkSize), FMath::FloorToInt(Offset.Y / ChunkSize));
+			auto AddTile = [&](const FBox2D& ClippedTile)
+			{
+				const int32* ChunkIndex = ChunkIndices.Find(ChunkCoord);
+				if (!ChunkIndex)
+				{
+					ChunkIndex = &ChunkIndices.Add(ChunkCoord, OutChunks.AddDefaulted());
+				}
+				OutChunks[*ChunkIndex].Add(ClippedTile);
+			};
+
+			if (Polygon.Num() > 0)
+			{
+				if (ParkourPlayArea::IsPointInPolygon(Tile.GetCenter(), Polygon))
+				{
+					AddTile(Tile);
+				}
+				continue;
+			}
+
+			// The rectangles do not overlap, so the pieces of a tile do not either
+			for (const FBox2D& Rect : Rects)
+			{
+				const FBox2D ClippedTile(Tile.Min.ComponentMax(Rect.Min), Tile.Max.ComponentMin(Rect.Max));
+				if (ClippedTile.Min.X < ClippedTile.Max.X && ClippedTile.Min.Y < ClippedTile.Max.Y)
+				{
+					AddTile(ClippedTile);
+				}
+			}
+		}
+	}
+}
+
+UProceduralMeshComponent* AParkourPlayArea::CreateFloorChunkMesh(const TArray<FBox2D>& Tiles, int32 ChunkIndex)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_MeshData);
+
+	FBox2D ChunkBounds(ForceInit);
+	for (const FBox2D& Tile : Tiles)
+	{
+		ChunkBounds += Tile;
+	}
+	const FVector2D Pivot = ChunkBounds.GetCenter();
+
+	const FString MeshName = FString::Printf(TEXT("Floor_%d"), ChunkIndex);
+	UProceduralMeshComponent* FloorMesh = NewObject<UProceduralMeshComponent>(this, *MeshName, FParkourCompactLayout::GetComponentFlags(LayoutStorage));
+	FloorMesh->SetupAttachment(RootComponent);
+	FloorMesh->RegisterComponent();
+
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UVs;
 	TArray<FColor> VertexColors;
-	FColor FloorColor(100, 100, 100, 255);
-	VertexColors.SetNum(4);
-	for (int32 i = 0; i < 4; i++)
+	Vertices.Reserve(Tiles.Num() * 4);
+	Triangles.Reserve(Tiles.Num() * 6);
+	Normals.Reserve(Tiles.Num() * 4);
+	UVs.Reserve(Tiles.Num() * 4);
+	VertexColors.Reserve(Tiles.Num() * 4);
+
+	const float TileSize = FMath::Max(FloorTileSize, 100.0f);
+	const FColor FloorColor(100, 100, 100, 255);
+
+	for (const FBox2D& Tile : Tiles)
 	{
-		VertexColors[i] = FloorColor;
+		const int32 First = Vertices.Num();
+		const FVector2D Corners[4] = {Tile.Min, FVector2D(Tile.Max.X, Tile.Min.Y), Tile.Max, FVector2D(Tile.Min.X, Tile.Max.Y)};
+		for (const FVector2D& Corner : Corners)
+		{
+			Vertices.Add(FVector(Corner - Pivot, 0.0f));
+			Normals.Add(FVector::UpVector);
+			// One texture repeat per tile, continuous across tiles and chunks
+			UVs.Add(Corner / TileSize);
+			VertexColors.Add(FloorColor);
+		}
+
+		Triangles.Append({First, First + 1, First + 2, First, First + 2, First + 3});
 	}
 
-	GeneratedFloorMesh->CreateMeshSection(0, Vertices, Triangles, Normals, UVs, VertexColors, TArray<FProcMeshTangent>(), true);
-	GeneratedFloorMesh->SetWorldLocation(GetActorLocation());
+	ParkourLLM::CreateMeshSection(*FloorMesh, 0, Vertices, Triangles, Normals, UVs, VertexColors);
+	FloorMesh->SetRelativeLocation(FVector(Pivot.X, Pivot.Y, -FloorOffset));
+
+	FloorMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	FloorMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
 
-	GeneratedFloorMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-	GeneratedFloorMesh->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+	return FloorMesh;
 }
 
-void AParkourPlayArea::GenerateUrbanBuildings(FRandomStream& RandomStream)
+int32 AParkourPlayArea::PlaceOnGridTiles(int32 Seed, float GridCellSize, TFunctionRef<bool(FRandomStream&, const FVector&, FBuildingCandidate&)> PlaceInCell, TArray<FBuildingCandidate>& OutCandidates) const
 {
 	FBox Bounds = GetAreaBounds();
 	FVector AreaSize = Bounds.GetSize();
 
-	// Calculate grid for building placement
-	float GridCellSize = FMath::Max(MaxBuildingSize.X, MaxBuildingSize.Y) * 1.5f;
 	int32 GridX = FMath::CeilToInt(AreaSize.X / GridCellSize);
 	int32 GridY = FMath::CeilToInt(AreaSize.Y / GridCellSize);
 
-	int32 BuildingIndex = 0;
+	// Tiles of cells are placed independently, each with its own stream derived from the seed and its coordinates
+	const int32 TileCells = 4;
+	const int32 TilesX = FMath::DivideAndRoundUp(GridX, TileCells);
+	const int32 TilesY = FMath::DivideAndRoundUp(GridY, TileCells);
 
-	for (int32 X = 0; X < GridX; X++)
+	TArray<TArray<FBuildingCandidate>> TileCandidates;
+	TileCandidates.SetNum(TilesX * TilesY);
+
+	ParallelFor(TileCandidates.Num(), [&](int32 TileIndex)
 	{
-		for (int32 Y = 0; Y < GridY; Y++)
+		// Worker threads do not inherit the caller's tag
+		LLM_SCOPE_BYTAG(ParkourGenerator_Environment);
+
+		const int32 TileX = TileIndex / TilesY;
+		const int32 TileY = TileIndex % TilesY;
+		FRandomStream RandomStream((int32)HashCombine(HashCombine(GetTypeHash(Seed), GetTypeHash(TileX)), GetTypeHash(TileY)));
+
+		for (int32 X = TileX * TileCells; X < FMath::Min((TileX + 1) * TileCells, GridX); X++)
 		{
-			// Apply density check
-			if (RandomStream.FRand() > BuildingDensity)
+			for (int32 Y = TileY * TileCells; Y < FMath::Min((TileY + 1) * TileCells, GridY); Y++)
 			{
-				continue;
-			}
+				FVector CellOrigin = Bounds.Min + FVector(X * GridCellSize, Y * GridCellSize, 0);
 
-			// Calculate cell position
-			FVector CellOrigin = Bounds.Min + FVector(X * GridCellSize, Y * GridCellSize, 0);
+				FBuildingCandidate Candidate;
+				if (PlaceInCell(RandomStream, CellOrigin, Candidate))
+				{
+					TileCandidates[TileIndex].Add(Candidate);
+				}
+			}
+		}
+	});
 
-			// Randomize position within cell
-			FVector BuildingPos = CellOrigin + FVector(
-				RandomStream.FRandRange(0, GridCellSize * 0.5f),
-				RandomStream.FRandRange(0, GridCellSize * 0.5f),
-				0
-			);
+	// Merged in tile order, so the result does not depend on how the tiles were scheduled
+	int32 NumAccepted = 0;
+	for (const TArray<FBuildingCandidate>& Candidates : TileCandidates)
+	{
+		for (const FBuildingCandidate& Candidate : Candidates)
+		{
+			NumAccepted += Candidate.bAccepted ? 1 : 0;
+		}
+		OutCandidates.Append(Candidates);
+	}
 
-			// Check if in play area
-			if (!IsPointInPlayArea(BuildingPos))
-			{
-				continue;
-			}
+	return NumAccepted;
+}
 
-			// Randomize building size
-			FVector BuildingSize;
-			BuildingSize.X = RandomStream.FRandRange(MinBuildingSize.X, MaxBuildingSize.X);
-			BuildingSize.Y = RandomStream.FRandRange(MinBuildingSize.Y, MaxBuildingSize.Y);
-			BuildingSize.Z = RandomStream.FRandRange(MinBuildingSize.Z, MaxBuildingSize.Z);
+void AParkourPlayArea::GenerateUrbanBuildings(int32 Seed, TArray<FBuildingCandidate>& OutCandidates, FParkourSolveStats* Stats, const TArray<FTransform>& Platforms) const
+{
+	// Calculate grid for building placement
+	float GridCellSize = FMath::Max(MaxBuildingSize.X, MaxBuildingSize.Y) * 1.5f;
 
-			// Check if placement is valid
-			if (!IsPlacementValid(BuildingPos, BuildingSize))
+	const int32 NumAccepted = PlaceOnGridTiles(Seed, GridCellSize, [this, GridCellSize, Stats, &Platforms](FRandomStream& RandomStream, const FVector& CellOrigin, FBuildingCandidate& OutCandidate)
+	{
+		// Apply density check
+		if (RandomStream.FRand() > BuildingDensity)
+		{
+			if (Stats)
 			{
-				continue;
+				Stats->RejectedDensity++;
 			}
+			return false;
+		}
+
+		// Randomize position within cell
+		FVector BuildingPos = CellOrigin + FVector(
+			RandomStream.FRandRange(0, GridCellSize * 0.5f),
+			RandomStream.FRandRange(0, GridCellSize * 0.5f),
+			0
+		);
 
-			// Create building
-			UProceduralMeshComponent* Building = CreateBuildingMesh(BuildingPos, BuildingSize, BuildingIndex);
-			if (Building)
+		// Check if in play area
+		if (!IsPointInPlayArea(BuildingPos))
+		{
+			if (Stats)
 			{
-				GeneratedBuildingMeshes.Add(Building);
-				BuildingIndex++;
+				Stats->RejectedOutsideArea++;
 			}
+			return false;
 		}
-	}
 
-	UE_LOG(LogTemp, Log, TEXT("Generated %d urban buildings"), BuildingIndex);
+		// Randomize building size
+		FVector BuildingSize;
+		BuildingSize.X = RandomStream.FRandRange(MinBuildingSize.X, MaxBuildingSize.X);
+		BuildingSize.Y = RandomStream.FRandRange(MinBuildingSize.Y, MaxBuildingSize.Y);
+		BuildingSize.Z = RandomStream.FRandRange(MinBuildingSize.Z, MaxBuildingSize.Z);
+
+		// Check if placement is valid, rejected candidates are kept for path edits
+		OutCandidate.Box = MakeBuildingBox(BuildingPos, BuildingSize);
+		OutCandidate.bAccepted = IsPlacementValid(BuildingPos, BuildingSize, Platforms, Stats);
+		return true;
+	}, OutCandidates);
+
+	UE_LOG(LogTemp, Verbose, TEXT("Generated %d urban buildings"), NumAccepted);
 }
 
-void AParkourPlayArea::GenerateIndustrialStructures(FRandomStream& RandomStream)
+void AParkourPlayArea::GenerateIndustrialStructures(int32 Seed, TArray<FBuildingCandidate>& OutCandidates, FParkourSolveStats* Stats, const TArray<FTransform>& Platforms) const
 {
 	// Similar to urban but with more horizontal structures
-	FBox Bounds = GetAreaBounds();
-	FVector AreaSize = Bounds.GetSize();
-
 	float GridCellSize = FMath::Max(MaxBuildingSize.X, MaxBuildingSize.Y) * 2.0f;
-	int32 GridX = FMath::CeilToInt(AreaSize.X / GridCellSize);
-	int32 GridY = FMath::CeilToInt(AreaSize.Y / GridCellSize);
-
-	int32 StructureIndex = 0;
 
-	for (int32 X = 0; X < GridX; X++)
+	const int32 NumAccepted = PlaceOnGridTiles(Seed, GridCellSize, [this, GridCellSize, Stats, &Platforms](FRandomStream& RandomStream, const FVector& CellOrigin, FBuildingCandidate& OutCandidate)
 	{
-		for (int32 Y = 0; Y < GridY; Y++)
+		if (RandomStream.FRand() > BuildingDensity * 0.8f) // Slightly less dense
 		{
-			if (RandomStream.FRand() > BuildingDensity * 0.8f) // Slightly less dense
+			if (Stats)
 			{
-				continue;
+				Stats->RejectedDensity++;
 			}
+			return false;
+		}
 
-			FVector CellOrigin = Bounds.Min + FVector(X * GridCellSize, Y * GridCellSize, 0);
-			FVector StructurePos = CellOrigin + FVector(
-				RandomStream.FRandRange(0, GridCellSize * 0.3f),
-				RandomStream.FRandRange(0, GridCellSize * 0.3f),
-				0
-			);
+		FVector StructurePos = CellOrigin + FVector(
+			RandomStream.FRandRange(0, GridCellSize * 0.3f),
+			RandomStream.FRandRange(0, GridCellSize * 0.3f),
+			0
+		);
 
-			if (!IsPointInPlayArea(StructurePos))
+		if (!IsPointInPlayArea(StructurePos))
+		{
+			if (Stats)
 			{
-				continue;
+				Stats->RejectedOutsideArea++;
 			}
+			return false;
+		}
 
-			// Industrial structures are wider and shorter
-			FVector StructureSize;
-			StructureSize.X = RandomStream.FRandRange(MinBuildingSize.X * 1.5f, MaxBuildingSize.X * 1.5f);
-			StructureSize.Y = RandomStream.FRandRange(MinBuildingSize.Y * 1.5f, MaxBuildingSize.Y * 1.5f);
-			StructureSize.Z = RandomStream.FRandRange(MinBuildingSize.Z * 0.5f, MaxBuildingSize.Z * 0.6f);
+		// Industrial structures are wider and shorter
+		FVector StructureSize;
+		StructureSize.X = RandomStream.FRandRange(MinBuildingSize.X * 1.5f, MaxBuildingSize.X * 1.5f);
+		StructureSize.Y = RandomStream.FRandRange(MinBuildingSize.Y * 1.5f, MaxBuildingSize.Y * 1.5f);
+		StructureSize.Z = RandomStream.FRandRange(MinBuildingSize.Z * 0.5f, MaxBuildingSize.Z * 0.6f);
 
-			if (!IsPlacementValid(StructurePos, StructureSize))
-			{
-				continue;
-			}
+		OutCandidate.Box = MakeBuildingBox(StructurePos, StructureSize);
+		OutCandidate.bAccepted = IsPlacementValid(StructurePos, StructureSize, Platforms, Stats);
+		return true;
+	}, OutCandidates);
 
-			UProceduralMeshComponent* Structure = CreateBuildingMesh(StructurePos, StructureSize, StructureIndex);
-			if (Structure)
-			{
-				GeneratedBuildingMeshes.Add(Structure);
-				StructureIndex++;
-			}
-		}
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("Generated %d industrial structures"), StructureIndex);
+	UE_LOG(LogTemp, Verbose, TEXT("Generated %d industrial structures"), NumAccepted);
 }
 
-void AParkourPlayArea::GenerateAbstractBlockout(FRandomStream& RandomStream)
+void AParkourPlayArea::GenerateAbstractBlockout(FRandomStream& RandomStream, TArray<FBuildingCandidate>& OutCandidates, FParkourSolveStats* Stats, const TArray<FTransform>& Platforms) const
 {
 	// Generate various sized blocks for abstract feeling
 	FBox Bounds = GetAreaBounds();
@@ -522,6 +792,10 @@ void AParkourPlayArea::GenerateAbstractBlockout(FRandomStream& RandomStream)
 
 		if (!IsPointInPlayArea(BlockPos))
 		{
+			if (Stats)
+			{
+				Stats->RejectedOutsideArea++;
+			}
 			continue;
 		}
 
@@ -531,55 +805,128 @@ void AParkourPlayArea::GenerateAbstractBlockout(FRandomStream& RandomStream)
 		BlockSize.Y = RandomStream.FRandRange(MinBuildingSize.Y * 0.5f, MaxBuildingSize.Y);
 		BlockSize.Z = RandomStream.FRandRange(MinBuildingSize.Z * 0.3f, MaxBuildingSize.Z * 1.2f);
 
-		if (!IsPlacementValid(BlockPos, BlockSize))
-		{
-			continue;
-		}
-
-		UProceduralMeshComponent* Block = CreateBuildingMesh(BlockPos, BlockSize, BlockIndex);
-		if (Block)
-		{
-			GeneratedBuildingMeshes.Add(Block);
-			BlockIndex++;
-		}
+		FBuildingCandidate& Candidate = OutCandidates.AddDefaulted_GetRef();
+		Candidate.Box = MakeBuildingBox(BlockPos, BlockSize);
+		Candidate.bAccepted = IsPlacementValid(BlockPos, BlockSize, Platforms, Stats);
+		BlockIndex += Candidate.bAccepted ? 1 : 0;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Generated %d abstract blocks"), BlockIndex);
+	UE_LOG(LogTemp, Verbose, TEXT("Generated %d abstract blocks"), BlockIndex);
 }
 
 void AParkourPlayArea::GenerateEnvironment()
 {
+	LLM_SCOPE_BYTAG(ParkourGenerator_Environment);
+
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	FParkourGenerationReport Report;
+	const double StartTime = Report.Start();
+	Report.Name = GetName();
+
 	ClearGeneratedEnvironment();
 
-	FRandomStream RandomStream;
-	if (EnvironmentSeed != 0)
+	// Placement queries the path BVH, make sure it matches the spline
+	if (ParkourPath)
+	{
+		ParkourPath->UpdatePathBVH();
+	}
+
+	// Seed 0 asks for a new layout every time
+	const int32 Seed = EnvironmentSeed != 0 ? EnvironmentSeed : FMath::Rand();
+
+	bool bCacheHit = false;
+
+#if WITH_EDITOR
+	// Unchanged inputs with a fixed seed give the same buildings, reuse them from the DDC
+	const FString CacheKey = FParkourGenerationCache::MakeEnvironmentKey(*this);
+	bCacheHit = FParkourGenerationCache::GetBuildings(CacheKey, GeneratedBuildingBoxes);
+#endif
+
+	if (bCacheHit)
 	{
-		RandomStream.Initialize(EnvironmentSeed);
+		UE_LOG(LogTemp, Log, TEXT("Reused %d cached buildings"), GeneratedBuildingBoxes.Num());
 	}
 	else
 	{
-		RandomStream.GenerateNewSeed();
+		const double SolveStart = FPlatformTime::Seconds();
+		FParkourSolveStats Stats;
+		TArray<FBuildingCandidate> Candidates;
+		SolveBuildingCandidates(Seed, Candidates, &Stats);
+		for (const FBuildingCandidate& Candidate : Candidates)
+		{
+			if (Candidate.bAccepted)
+			{
+				GeneratedBuildingBoxes.Add(Candidate.Box);
+			}
+		}
+		RecordCandidates(MoveTemp(Candidates), Seed);
+		Report.SolveTimeMs = FParkourGenerationReport::MillisecondsSince(SolveStart);
+		Report.AddSolveStats(Stats);
+
+		UE_LOG(LogTemp, Log, TEXT("Generated %d buildings"), GeneratedBuildingBoxes.Num());
+
+#if WITH_EDITOR
+		FParkourGenerationCache::PutBuildings(CacheKey, GeneratedBuildingBoxes);
+#endif
 	}
 
-	// Generate floor if requested
-	if (bGenerateFloor)
+	// Record the layout, this is what gets saved with the level
+	CompactLayout.Seed = Seed;
+	CompactLayout.SetBuildings(GeneratedBuildingBoxes, LayoutStorage == EParkourLayoutStorage::CompactLayout);
+	CompactLayout.bFloor = bGenerateFloor;
+
+	const double MeshStart = FPlatformTime::Seconds();
+	CommitEnvironmentMeshes();
+	Report.MeshTimeMs = FParkourGenerationReport::MillisecondsSince(MeshStart);
+
+	Report.Seed = Seed;
+	Report.CacheHits = bCacheHit ? 1 : 0;
+	Report.Buildings = GeneratedBuildingBoxes.Num();
+	Report.AddMeshes(GeneratedBuildingMeshes);
+	Report.AddMeshes(GeneratedFloorMeshes);
+	Report.Finish(StartTime);
+	LastGenerationReport = Report;
+}
+
+void AParkourPlayArea::SolveBuildings(int32 Seed, TArray<FBox>& OutBuildings, FParkourSolveStats* Stats, const TArray<FTransform>* Platforms) const
+{
+	TArray<FBuildingCandidate> Candidates;
+	SolveBuildingCandidates(Seed, Candidates, Stats, Platforms);
+
+	OutBuildings.Reset();
+	for (const FBuildingCandidate& Candidate : Candidates)
 	{
-		CreateFloorMesh();
+		if (Candidate.bAccepted)
+		{
+			OutBuildings.Add(Candidate.Box);
+		}
 	}
+}
+
+void AParkourPlayArea::SolveBuildingCandidates(int32 Seed, TArray<FBuildingCandidate>& OutCandidates, FParkourSolveStats* Stats, const TArray<FTransform>* Platforms) const
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Environment);
+
+	const TArray<FTransform> NoPlatforms;
+	const TArray<FTransform>& AvoidedPlatforms = Platforms ? *Platforms : ParkourPath ? ParkourPath->GeneratedPlatformTransforms : NoPlatforms;
+
+	FRandomStream RandomStream(Seed);
+	OutCandidates.Reset();
 
 	// Generate environment based on style
 	switch (EnvironmentStyle)
 	{
 	case EParkourEnvironmentStyle::Urban:
-		GenerateUrbanBuildings(RandomStream);
+		GenerateUrbanBuildings(Seed, OutCandidates, Stats, AvoidedPlatforms);
 		break;
 
 	case EParkourEnvironmentStyle::Industrial:
-		GenerateIndustrialStructures(RandomStream);
+		GenerateIndustrialStructures(Seed, OutCandidates, Stats, AvoidedPlatforms);
 		break;
 
 	case EParkourEnvironmentStyle::Abstract:
-		GenerateAbstractBlockout(RandomStream);
+		GenerateAbstractBlockout(RandomStream, OutCandidates, Stats, AvoidedPlatforms);
 		break;
 
 	case EParkourEnvironmentStyle::None:
@@ -588,26 +935,622 @@ void AParkourPlayArea::GenerateEnvironment()
 	}
 }
 
+uint32 AParkourPlayArea::GetCandidateInputHash(int32 Seed) const
+{
+	TArray<uint8> Inputs;
+	FMemoryWriter Ar(Inputs);
+	auto HashValue = [&Ar](auto Value)
+	{
+		Ar << Value;
+	};
+
+	HashValue(Seed);
+	HashValue(GetActorTransform());
+	HashValue((uint8)AreaShape);
+	HashValue(AreaDimensions);
+	HashValue(LShapeArmWidth);
+	HashValue(UShapeArmWidth);
+	HashValue((uint8)EnvironmentStyle);
+	HashValue(PathClearance);
+	HashValue(BuildingDensity);
+	HashValue(MinBuildingSize);
+	HashValue(MaxBuildingSize);
+
+	// Which path is avoided, and whether its platforms are
+	HashValue(ParkourPath ? ParkourPath->GetUniqueID() : 0u);
+	HashValue(ParkourPath && ParkourPath->IsUsingRooftopsOf(this));
+
+	return FCrc::MemCrc32(Inputs.GetData(), Inputs.Num());
+}
+
+void AParkourPlayArea::RecordCandidates(TArray<FBuildingCandidate>&& Candidates, int32 Seed)
+{
+	BuildingCandidates = MoveTemp(Candidates);
+	CandidateInputHash = GetCandidateInputHash(Seed);
+
+	CandidatePathPoints.Reset();
+	CandidatePlatforms.Reset();
+	if (ParkourPath)
+	{
+		CandidatePathPoints = ParkourPath->GetPathBVH().GetPoints();
+
+		// Platforms of a rooftop route are not checked
+		if (!ParkourPath->IsUsingRooftopsOf(this))
+		{
+			for (const FTransform& Platform : ParkourPath->GeneratedPlatformTransforms)
+			{
+				CandidatePlatforms.Add(Platform.GetLocation());
+			}
+		}
+	}
+}
+
+int32 AParkourPlayArea::RecheckCandidates(FParkourSolveStats& Stats)
+{
+	const TArray<FVector> NoPoints;
+	const TArray<FVector>& PathPoints = ParkourPath ? ParkourPath->GetPathBVH().GetPoints() : NoPoints;
+
+	// The stretch of the polyline between the points matching at the start and at the end, in the old and the new path
+	const int32 OldNum = CandidatePathPoints.Num();
+	const int32 NewNum = PathPoints.Num();
+	const int32 MaxMatching = FMath::Min(OldNum, NewNum);
+
+	int32 Prefix = 0;
+	while (Prefix < MaxMatching && CandidatePathPoints[Prefix] == PathPoints[Prefix])
+	{
+		Prefix++;
+	}
+
+	int32 Suffix = 0;
+	while (Suffix < MaxMatching - Prefix && CandidatePathPoints[OldNum - 1 - Suffix] == PathPoints[NewNum - 1 - Suffix])
+	{
+		Suffix++;
+	}
+
+	auto GetStretch = [Prefix, Suffix](const TArray<FVector>& Points)
+	{
+		const int32 First = FMath::Max(Prefix - 1, 0);
+		const int32 End = FMath::Min(Points.Num() - Suffix + 1, Points.Num());
+		return TArray<FVector>(Points.GetData() + First, FMath::Max(End - First, 0));
+	};
+
+	FParkourPathBVH OldStretch;
+	FParkourPathBVH NewStretch;
+	OldStretch.Build(GetStretch(CandidatePathPoints), 100.0f);
+	NewStretch.Build(GetStretch(PathPoints), 100.0f);
+
+	// Platforms that were added, removed or moved
+	TArray<FVector> Platforms;
+	if (ParkourPath && !ParkourPath->IsUsingRooftopsOf(this))
+	{
+		for (const FTransform& Platform : ParkourPath->GeneratedPlatformTransforms)
+		{
+			Platforms.Add(Platform.GetLocation());
+		}
+	}
+
+	const TSet<FVector> OldPlatformSet(CandidatePlatforms);
+	const TSet<FVector> NewPlatformSet(Platforms);
+	TArray<FVector> ChangedPlatforms;
+	for (const FVector& Platform : CandidatePlatforms)
+	{
+		if (!NewPlatformSet.Contains(Platform))
+		{
+			ChangedPlatforms.Add(Platform);
+		}
+	}
+	for (const FVector& Platform : Platforms)
+	{
+		if (!OldPlatformSet.Contains(Platform))
+		{
+			ChangedPlatforms.Add(Platform);
+		}
+	}
+
+	// Candidates out of PathClearance of everything that changed pass or fail exactly as before
+	TArray<int32> Dirty;
+	for (int32 i = 0; i < BuildingCandidates.Num(); i++)
+	{
+		const FBox& Box = BuildingCandidates[i].Box;
+		const FBox2D Footprint(FVector2D(Box.Min.X, Box.Min.Y), FVector2D(Box.Max.X, Box.Max.Y));
+
+		bool bDirty = OldStretch.OverlapsFootprint(Footprint, PathClearance) || NewStretch.OverlapsFootprint(Footprint, PathClearance);
+		for (int32 p = 0; p < ChangedPlatforms.Num() && !bDirty; p++)
+		{
+			bDirty = Footprint.ComputeSquaredDistanceToPoint(FVector2D(ChangedPlatforms[p].X, ChangedPlatforms[p].Y)) < FMath::Square(PathClearance);
+		}
+
+		if (bDirty)
+		{
+			Dirty.Add(i);
+		}
+	}
+
+	const TArray<FTransform> NoPlatforms;
+	const TArray<FTransform>& PathPlatforms = ParkourPath ? ParkourPath->GeneratedPlatformTransforms : NoPlatforms;
+
+	ParallelFor(Dirty.Num(), [this, &Dirty, &Stats, &PathPlatforms](int32 DirtyIndex)
+	{
+		LLM_SCOPE_BYTAG(ParkourGenerator_Environment);
+
+		FBuildingCandidate& Candidate = BuildingCandidates[Dirty[DirtyIndex]];
+		const FVector Center = Candidate.Box.GetCenter();
+		Candidate.bAccepted = IsPlacementValid(FVector(Center.X, Center.Y, Candidate.Box.Min.Z), Candidate.Box.GetSize(), PathPlatforms, &Stats);
+	});
+
+	CandidatePathPoints = PathPoints;
+	CandidatePlatforms = MoveTemp(Platforms);
+
+	return Dirty.Num();
+}
+
+void AParkourPlayArea::UpdateEnvironmentForPath()
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Environment);
+
+	const int32 Seed = CompactLayout.Seed;
+
+	// Meshes are matched to buildings by index, which needs all of them created since the last generation
+	bool bMeshesMatched = !HasPendingMeshes() && BuildingMeshes.Num() == GeneratedBuildingBoxes.Num();
+	for (int32 i = 0; i < BuildingMeshes.Num() && bMeshesMatched; i++)
+	{
+		bMeshesMatched = BuildingMeshes[i].IsValid();
+	}
+
+	const bool bGenerated = GeneratedBuildingMeshes.Num() > 0 || GeneratedFloorMeshes.Num() > 0;
+	const bool bSeedChanged = EnvironmentSeed != 0 && EnvironmentSeed != Seed;
+	const bool bAreaChanged = BuildingCandidates.Num() > 0 && CandidateInputHash != GetCandidateInputHash(Seed);
+	if (!bGenerated || !bMeshesMatched || bSeedChanged || bAreaChanged)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Environment of %s cannot be updated in place, generating it again"), *GetName());
+		GenerateEnvironment();
+		return;
+	}
+
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	FParkourGenerationReport Report;
+	const double StartTime = Report.Start();
+	Report.Name = GetName();
+
+	if (ParkourPath)
+	{
+		ParkourPath->UpdatePathBVH();
+	}
+
+	const double SolveStart = FPlatformTime::Seconds();
+	FParkourSolveStats Stats;
+	int32 NumChecked = 0;
+	if (BuildingCandidates.Num() > 0)
+	{
+		NumChecked = RecheckCandidates(Stats);
+	}
+	else
+	{
+		// The buildings came from the generation cache or a saved level, solving them again still spares their meshes
+		TArray<FBuildingCandidate> Candidates;
+		SolveBuildingCandidates(Seed, Candidates, &Stats);
+		RecordCandidates(MoveTemp(Candidates), Seed);
+		NumChecked = BuildingCandidates.Num();
+	}
+	Report.SolveTimeMs = FParkourGenerationReport::MillisecondsSince(SolveStart);
+	Report.AddSolveStats(Stats);
+
+	// The buildings are the accepted candidates in order, match the current ones against them
+	TArray<FBox> NewBoxes;
+	TArray<TWeakObjectPtr<UProceduralMeshComponent>> NewMeshes;
+	TArray<int32> Evicted;
+	int32 OldIndex = 0;
+	for (const FBuildingCandidate& Candidate : BuildingCandidates)
+	{
+		// Boxes restored from the compact record are quantized to millimeters
+		const bool bExisted = GeneratedBuildingBoxes.IsValidIndex(OldIndex)
+			&& GeneratedBuildingBoxes[OldIndex].Min.Equals(Candidate.Box.Min, 1.0f)
+			&& GeneratedBuildingBoxes[OldIndex].Max.Equals(Candidate.Box.Max, 1.0f);
+
+		if (bExisted && Candidate.bAccepted)
+		{
+			NewBoxes.Add(GeneratedBuildingBoxes[OldIndex]);
+			NewMeshes.Add(BuildingMeshes[OldIndex]);
+		}
+		else if (Candidate.bAccepted)
+		{
+			NewBoxes.Add(Candidate.Box);
+			NewMeshes.AddDefaulted();
+		}
+		else if (bExisted)
+		{
+			Evicted.Add(OldIndex);
+		}
+
+		OldIndex += bExisted ? 1 : 0;
+	}
+
+	// Buildings that are not candidates were not solved with these settings (e.g. an imported layout)
+	if (OldIndex != GeneratedBuildingBoxes.Num())
+	{
+		UE_LOG(LogTemp, Log, TEXT("Buildings of %s do not match its settings, generating them again"), *GetName());
+		GenerateEnvironment();
+		return;
+	}
+
+	for (int32 Index : Evicted)
+	{
+		if (UProceduralMeshComponent* Mesh = BuildingMeshes[Index].Get())
+		{
+			FParkourNavigationBatch::AddDirtyComponent(Mesh);
+			GeneratedBuildingMeshes.RemoveSingle(Mesh);
+			Mesh->DestroyComponent();
+		}
+	}
+
+	GeneratedBuildingBoxes = MoveTemp(NewBoxes);
+	BuildingMeshes = MoveTemp(NewMeshes);
+	CompactLayout.SetBuildings(GeneratedBuildingBoxes, LayoutStorage == EParkourLayoutStorage::CompactLayout);
+
+	// Only the added buildings get meshes
+	const double MeshStart = FPlatformTime::Seconds();
+	bMeshCreationActive = true;
+	PendingMeshes.Reset();
+	NextPendingMesh = 0;
+	for (int32 i = 0; i < BuildingMeshes.Num(); i++)
+	{
+		if (!BuildingMeshes[i].IsValid())
+		{
+			PendingMeshes.Add(i);
+		}
+	}
+	const int32 NumAdded = PendingMeshes.Num();
+	CreateQueuedMeshes();
+	Report.MeshTimeMs = FParkourGenerationReport::MillisecondsSince(MeshStart);
+
+	UE_LOG(LogTemp, Log, TEXT("Updated environment of %s: %d of %d candidates checked again, %d buildings removed, %d added"),
+		*GetName(), NumChecked, BuildingCandidates.Num(), Evicted.Num(), NumAdded);
+
+	Report.Seed = Seed;
+	Report.Buildings = GeneratedBuildingBoxes.Num();
+	Report.AddMeshes(GeneratedBuildingMeshes);
+	Report.AddMeshes(GeneratedFloorMeshes);
+	Report.Finish(StartTime);
+	LastGenerationReport = Report;
+}
+
+void AParkourPlayArea::ApplyBuildingLayout(const TArray<FBox>& BuildingBoxes, bool bWithFloor, int32 Seed)
+{
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	ApplyBuildingLayoutDeferred(BuildingBoxes, bWithFloor, Seed);
+
+	while (CreateNextPendingMesh())
+	{
+	}
+}
+
+void AParkourPlayArea::ApplyBuildingLayoutDeferred(const TArray<FBox>& BuildingBoxes, bool bWithFloor, int32 Seed)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Environment);
+
+	// The old meshes go in the same time slices the new ones are created in
+	QueueGeneratedRemoval();
+
+	GeneratedBuildingBoxes = BuildingBoxes;
+	CompactLayout.Seed = Seed;
+	CompactLayout.SetBuildings(GeneratedBuildingBoxes, LayoutStorage == EParkourLayoutStorage::CompactLayout);
+	CompactLayout.bFloor = bWithFloor;
+
+	QueueEnvironmentMeshes();
+}
+
+void AParkourPlayArea::CreateEnvironmentMeshes()
+{
+	QueueEnvironmentMeshes();
+
+	while (CreateNextPendingMesh())
+	{
+	}
+}
+
+void AParkourPlayArea::CommitEnvironmentMeshes()
+{
+	QueueEnvironmentMeshes();
+	CreateQueuedMeshes();
+}
+
+void AParkourPlayArea::CreateQueuedMeshes()
+{
+	UWorld* World = GetWorld();
+	UParkourWorldSubsystem* Subsystem = World ? World->GetSubsystem<UParkourWorldSubsystem>() : nullptr;
+	if (bIncrementalGeneration && Subsystem)
+	{
+		Subsystem->RequestMeshCreation(nullptr, this);
+		return;
+	}
+
+	while (CreateNextPendingMesh())
+	{
+	}
+}
+
+void AParkourPlayArea::QueueEnvironmentMeshes()
+{
+	bMeshCreationActive = true;
+
+	// Generate floor if requested
+	PendingFloorChunks.Reset();
+	NextPendingFloorChunk = 0;
+	if (CompactLayout.bFloor)
+	{
+		BuildFloorChunks(PendingFloorChunks);
+	}
+
+	PendingMeshes.Reset(GeneratedBuildingBoxes.Num());
+	NextPendingMesh = 0;
+	BuildingMeshes.Reset();
+	BuildingMeshes.SetNum(GeneratedBuildingBoxes.Num());
+	for (int32 i = 0; i < GeneratedBuildingBoxes.Num(); i++)
+	{
+		PendingMeshes.Add(i);
+	}
+}
+
+void AParkourPlayArea::SortPendingMeshes(const FVector& ViewLocation)
+{
+	TArrayView<int32> Remaining(PendingMeshes.GetData() + NextPendingMesh, PendingMeshes.Num() - NextPendingMesh);
+	Algo::SortBy(Remaining, [this, &ViewLocation](int32 Index)
+	{
+		return GeneratedBuildingBoxes[Index].ComputeSquaredDistanceToPoint(ViewLocation);
+	});
+}
+
+bool AParkourPlayArea::CreateNextPendingMesh()
+{
+	if (PendingRemovals.Num() > 0)
+	{
+		UPrimitiveComponent* Component = PendingRemovals.Pop(false);
+		if (Component)
+		{
+			FParkourNavigationBatch::AddDirtyComponent(Component);
+			Component->DestroyComponent();
+		}
+		return true;
+	}
+
+	if (NextPendingFloorChunk < PendingFloorChunks.Num())
+	{
+		const int32 ChunkIndex = NextPendingFloorChunk++;
+		UProceduralMeshComponent* FloorMesh = CreateFloorChunkMesh(PendingFloorChunks[ChunkIndex], ChunkIndex);
+		FParkourNavigationBatch::AddDirtyComponent(FloorMesh);
+		GeneratedFloorMeshes.Add(FloorMesh);
+		return true;
+	}
+
+	if (NextPendingMesh >= PendingMeshes.Num())
+	{
+		PendingMeshes.Reset();
+		NextPendingMesh = 0;
+		PendingFloorChunks.Reset();
+		NextPendingFloorChunk = 0;
+
+		if (bMeshCreationActive)
+		{
+			bMeshCreationActive = false;
+			OnGenerationCompleted.Broadcast();
+		}
+		return false;
+	}
+
+	const int32 Index = PendingMeshes[NextPendingMesh++];
+	const FBox& Box = GeneratedBuildingBoxes[Index];
+	const FVector Center = Box.GetCenter();
+
+	UProceduralMeshComponent* Building = CreateBuildingMesh(FVector(Center.X, Center.Y, Box.Min.Z), Box.GetSize(), Index);
+	if (Building)
+	{
+		FParkourNavigationBatch::AddDirtyComponent(Building);
+		GeneratedBuildingMeshes.Add(Building);
+		BuildingMeshes[Index] = Building;
+	}
+
+	return true;
+}
+
+void AParkourPlayArea::ApplyLayoutStorage()
+{
+	// Re-record so only Compact Layout storage keeps quantized boxes
+	if (GeneratedBuildingBoxes.Num() > 0)
+	{
+		CompactLayout.SetBuildings(GeneratedBuildingBoxes, LayoutStorage == EParkourLayoutStorage::CompactLayout);
+	}
+
+	TArray<UProceduralMeshComponent*> Meshes = GeneratedBuildingMeshes;
+	Meshes.Append(GeneratedFloorMeshes);
+
+	for (UProceduralMeshComponent* Mesh : Meshes)
+	{
+		if (!Mesh)
+		{
+			continue;
+		}
+
+		if (LayoutStorage == EParkourLayoutStorage::CompactLayout)
+		{
+			Mesh->SetFlags(RF_Transient);
+		}
+		else
+		{
+			Mesh->ClearFlags(RF_Transient);
+		}
+	}
+}
+
+FBox AParkourPlayArea::MakeBuildingBox(const FVector& Location, const FVector& Size)
+{
+	return FBox(
+		Location - FVector(Size.X * 0.5f, Size.Y * 0.5f, 0),
+		Location + FVector(Size.X * 0.5f, Size.Y * 0.5f, Size.Z)
+	);
+}
+
 void AParkourPlayArea::ClearGeneratedEnvironment()
 {
-	for (UProceduralMeshComponent* Mesh : GeneratedBuildingMeshes)
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	QueueGeneratedRemoval();
+
+	// Destroy buildings, floor chunks and baked meshes
+	for (UPrimitiveComponent* Component : PendingRemovals)
+	{
+		if (Component)
+		{
+			FParkourNavigationBatch::AddDirtyComponent(Component);
+			Component->DestroyComponent();
+		}
+	}
+	PendingRemovals.Empty();
+}
+
+void AParkourPlayArea::QueueGeneratedRemoval()
+{
+	PendingRemovals.Append(GeneratedBuildingMeshes);
+	PendingRemovals.Append(GeneratedFloorMeshes);
+	PendingRemovals.Append(BakedEnvironmentMeshes);
+	GeneratedBuildingMeshes.Empty();
+	GeneratedFloorMeshes.Empty();
+	BakedEnvironmentMeshes.Empty();
+
+	GeneratedBuildingBoxes.Empty();
+	BuildingMeshes.Empty();
+	BuildingCandidates.Empty();
+	CandidatePathPoints.Empty();
+	CandidatePlatforms.Empty();
+	PendingMeshes.Empty();
+	NextPendingMesh = 0;
+	PendingFloorChunks.Empty();
+	NextPendingFloorChunk = 0;
+	bMeshCreationActive = false;
+	CompactLayout.Reset();
+}
+
+#if WITH_EDITOR
+void AParkourPlayArea::BakeToStaticMeshes()
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_MeshData);
+
+	TArray<UProceduralMeshComponent*> SourceMeshes = GeneratedBuildingMeshes;
+	SourceMeshes.Append(GeneratedFloorMeshes);
+
+	if (SourceMeshes.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Nothing to bake on %s, generate environment first"), *GetName());
+		return;
+	}
+
+	const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+	const float ChunkSize = Settings->BakeChunkSize;
+	const FVector Origin = GetAreaBounds().Min;
+
+	// Group meshes into grid chunks by their location so each chunk can be culled and streamed on its own
+	TMap<FIntPoint, TArray<UProceduralMeshComponent*>> Chunks;
+	for (UProceduralMeshComponent* Mesh : SourceMeshes)
+	{
+		if (!Mesh)
+		{
+			continue;
+		}
+
+		const FVector Offset = Mesh->GetComponentLocation() - Origin;
+		const FIntPoint ChunkCoord(FMath::FloorToInt(Offset.X / ChunkSize), FMath::FloorToInt(Offset.Y / ChunkSize));
+		Chunks.FindOrAdd(ChunkCoord).Add(Mesh);
+	}
+
+	struct FBakedChunk
+	{
+		const TArray<UProceduralMeshComponent*>* Sources;
+		FTransform Pivot;
+		FString Name;
+		UStaticMesh* Mesh;
+	};
+
+	// Bake every chunk before touching any component, so a failed chunk leaves the environment as it was
+	TArray<FBakedChunk> BakedChunks;
+	for (const TPair<FIntPoint, TArray<UProceduralMeshComponent*>>& Chunk : Chunks)
+	{
+		// Pivot each chunk at its own corner so the baked mesh bounds stay tight
+		FTransform Pivot = GetActorTransform();
+		Pivot.SetLocation(Origin + FVector(Chunk.Key.X * ChunkSize, Chunk.Key.Y * ChunkSize, 0));
+
+		const FString ChunkName = FString::Printf(TEXT("Chunk_%d_%d"), Chunk.Key.X, Chunk.Key.Y);
+		UStaticMesh* BakedMesh = FParkourMeshBaker::BakeToStaticMesh(
+			Chunk.Value,
+			Pivot,
+			Settings->BakedAssetPath,
+			FParkourMeshBaker::MakeAssetName(this, ChunkName)
+		);
+
+		if (!BakedMesh)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Failed to bake %s of %s, keeping the procedural environment"), *ChunkName, *GetName());
+			return;
+		}
+
+		BakedChunks.Add({&Chunk.Value, Pivot, ChunkName, BakedMesh});
+	}
+
+	for (UStaticMeshComponent* Mesh : BakedEnvironmentMeshes)
 	{
 		if (Mesh)
 		{
 			Mesh->DestroyComponent();
 		}
 	}
-	GeneratedBuildingMeshes.Empty();
+	BakedEnvironmentMeshes.Empty();
 
-	if (GeneratedFloorMesh)
+	// Only meshes whose chunk got a baked component are replaced
+	TSet<UProceduralMeshComponent*> BakedSources;
+	for (const FBakedChunk& Chunk : BakedChunks)
 	{
-		GeneratedFloorMesh->DestroyComponent();
-		GeneratedFloorMesh = nullptr;
+		UStaticMeshComponent* BakedComponent = FParkourMeshBaker::CreateBakedComponent(this, Chunk.Mesh, Chunk.Pivot, FString::Printf(TEXT("Baked_%s"), *Chunk.Name));
+		if (BakedComponent)
+		{
+			BakedEnvironmentMeshes.Add(BakedComponent);
+			BakedSources.Append(*Chunk.Sources);
+		}
 	}
+
+	// Swap the procedural environment for the baked chunks
+	auto DestroyBaked = [&BakedSources](UProceduralMeshComponent* Mesh)
+	{
+		if (Mesh && BakedSources.Contains(Mesh))
+		{
+			Mesh->DestroyComponent();
+			return true;
+		}
+		return !Mesh;
+	};
+	GeneratedBuildingMeshes.RemoveAll(DestroyBaked);
+	GeneratedFloorMeshes.RemoveAll(DestroyBaked);
+
+	if (GeneratedBuildingMeshes.Num() == 0)
+	{
+		BuildingMeshes.Empty();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Baked environment into %d chunks"), BakedEnvironmentMeshes.Num());
 }
+#endif
 
 void AParkourPlayArea::GenerateAll()
 {
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
+	// A path that lands on these rooftops needs the buildings first
+	if (ParkourPath && ParkourPath->IsUsingRooftopsOf(this))
+	{
+		GenerateEnvironment();
+		ParkourPath->GenerateParkour();
+		return;
+	}
+
 	// First generate parkour path platforms
 	if (ParkourPath)
 	{
@@ -620,6 +1563,8 @@ void AParkourPlayArea::GenerateAll()
 
 void AParkourPlayArea::ClearAll()
 {
+	FParkourNavigationBatch NavigationBatch(GetWorld());
+
 	if (ParkourPath)
 	{
 		ParkourPath->ClearGeneratedParkour();
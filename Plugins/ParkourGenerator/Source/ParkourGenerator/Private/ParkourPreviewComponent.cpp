@@ -0,0 +1,257 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourPreviewComponent.h"
+#include "ParkourLLM.h"
+#include "PrimitiveSceneProxy.h"
+#include "SceneManagement.h"
+#include "SceneView.h"
+
+namespace ParkourPreview
+{
+	/** Seven segment digits: top, top right, bottom right, bottom, bottom left, top left, middle */
+	static const FVector4 DigitSegments[7] =
+	{
+		FVector4(0, 2, 1, 2),
+		FVector4(1, 2, 1, 1),
+		FVector4(1, 1, 1, 0),
+		FVector4(0, 0, 1, 0),
+		FVector4(0, 0, 0, 1),
+		FVector4(0, 1, 0, 2),
+		FVector4(0, 1, 1, 1)
+	};
+
+	static const uint8 DigitMasks[10] =
+	{
+		0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+	};
+
+	/** Horizontal distance between two digits, in units of half the digit height */
+	static constexpr float DigitAdvance = 1.5f;
+}
+
+/** Draws the preview lines and labels of a UParkourPreviewComponent */
+class FParkourPreviewSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+	FParkourPreviewSceneProxy(const UParkourPreviewComponent* Component)
+		: FPrimitiveSceneProxy(Component)
+		, Lines(Component->GetLines())
+		, Labels(Component->GetLabels())
+		, LabelSegments(Component->GetLabelSegments())
+		, LabelScale(Component->LabelSize * 0.5f)
+	{
+	}
+
+	virtual SIZE_T GetTypeHash() const override
+	{
+		static size_t UniquePointer;
+		return reinterpret_cast<size_t>(&UniquePointer);
+	}
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override
+	{
+		const FMatrix& LocalToWorld = GetLocalToWorld();
+
+		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+		{
+			if (!(VisibilityMap & (1 << ViewIndex)))
+			{
+				continue;
+			}
+
+			FPrimitiveDrawInterface* PDI = Collector.GetPDI(ViewIndex);
+
+			for (const UParkourPreviewComponent::FLine& Line : Lines)
+			{
+				PDI->DrawLine(LocalToWorld.TransformPosition(Line.Start), LocalToWorld.TransformPosition(Line.End), Line.Color, SDPG_World, Line.Thickness);
+			}
+
+			// Labels face the view
+			const FVector Right = Views[ViewIndex]->GetViewRight() * LabelScale;
+			const FVector Up = Views[ViewIndex]->GetViewUp() * LabelScale;
+
+			for (const UParkourPreviewComponent::FLabel& Label : Labels)
+			{
+				const FVector Origin = LocalToWorld.TransformPosition(Label.Location);
+
+				for (int32 i = Label.FirstSegment; i < Label.FirstSegment + Label.NumSegments; i++)
+				{
+					const FVector4& Segment = LabelSegments[i];
+					PDI->DrawLine(Origin + Right * Segment.X + Up * Segment.Y, Origin + Right * Segment.Z + Up * Segment.W, Label.Color, SDPG_World, 1.0f);
+				}
+			}
+		}
+	}
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+	{
+		FPrimitiveViewRelevance Result;
+		Result.bDrawRelevance = IsShown(View);
+		Result.bDynamicRelevance = true;
+		Result.bShadowRelevance = false;
+		Result.bEditorPrimitiveRelevance = UseEditorCompositing(View);
+		return Result;
+	}
+
+	virtual uint32 GetMemoryFootprint() const override
+	{
+		return sizeof(*this) + GetAllocatedSize();
+	}
+
+	uint32 GetAllocatedSize() const
+	{
+		return FPrimitiveSceneProxy::GetAllocatedSize() + Lines.GetAllocatedSize() + Labels.GetAllocatedSize() + LabelSegments.GetAllocatedSize();
+	}
+
+private:
+	TArray<UParkourPreviewComponent::FLine> Lines;
+	TArray<UParkourPreviewComponent::FLabel> Labels;
+	TArray<FVector4> LabelSegments;
+	float LabelScale;
+};
+
+UParkourPreviewComponent::UParkourPreviewComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	bIsEditorOnly = true;
+	bHiddenInGame = true;
+	bSelectable = false;
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetGenerateOverlapEvents(false);
+	CastShadow = false;
+
+	LocalBounds.Init();
+}
+
+bool UParkourPreviewComponent::BeginPreview(uint32 SourceHash)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Preview);
+
+	if (bHasPreview && PreviewHash == SourceHash)
+	{
+		return false;
+	}
+
+	Lines.Reset();
+	Labels.Reset();
+	LabelSegments.Reset();
+	LocalBounds.Init();
+
+	PreviewHash = SourceHash;
+	bHasPreview = true;
+	return true;
+}
+
+void UParkourPreviewComponent::ClearPreview()
+{
+	if (!bHasPreview)
+	{
+		return;
+	}
+
+	Lines.Empty();
+	Labels.Empty();
+	LabelSegments.Empty();
+	LocalBounds.Init();
+	bHasPreview = false;
+
+	CommitPreview();
+}
+
+void UParkourPreviewComponent::AddLine(const FVector& Start, const FVector& End, const FColor& Color, float Thickness)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Preview);
+
+	const FTransform& ComponentTransform = GetComponentTransform();
+	const FVector LocalStart = ComponentTransform.InverseTransformPosition(Start);
+	const FVector LocalEnd = ComponentTransform.InverseTransformPosition(End);
+
+	Lines.Add({LocalStart, LocalEnd, Color, Thickness});
+	LocalBounds += LocalStart;
+	LocalBounds += LocalEnd;
+}
+
+void UParkourPreviewComponent::AddBox(const FVector& Center, const FVector& Extent, const FQuat& Rotation, const FColor& Color, float Thickness)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Preview);
+
+	FVector Corners[8];
+	for (int32 i = 0; i < 8; i++)
+	{
+		const FVector Corner((i & 1) ? Extent.X : -Extent.X, (i & 2) ? Extent.Y : -Extent.Y, (i & 4) ? Extent.Z : -Extent.Z);
+		Corners[i] = Center + Rotation.RotateVector(Corner);
+	}
+
+	// Corners differing in exactly one bit share an edge
+	for (int32 i = 0; i < 8; i++)
+	{
+		for (int32 Bit = 1; Bit < 8; Bit <<= 1)
+		{
+			if (!(i & Bit))
+			{
+				AddLine(Corners[i], Corners[i | Bit], Color, Thickness);
+			}
+		}
+	}
+}
+
+void UParkourPreviewComponent::AddLabel(const FVector& Location, int32 Number, const FColor& Color)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Preview);
+
+	const FString Digits = FString::FromInt(FMath::Abs(Number));
+	const float HalfWidth = (Digits.Len() * ParkourPreview::DigitAdvance - 0.5f) * 0.5f;
+
+	FLabel& Label = Labels.AddDefaulted_GetRef();
+	Label.Location = GetComponentTransform().InverseTransformPosition(Location);
+	Label.Color = Color;
+	Label.FirstSegment = LabelSegments.Num();
+
+	for (int32 DigitIndex = 0; DigitIndex < Digits.Len(); DigitIndex++)
+	{
+		const float OffsetX = DigitIndex * ParkourPreview::DigitAdvance - HalfWidth;
+		const uint8 Mask = ParkourPreview::DigitMasks[Digits[DigitIndex] - TEXT('0')];
+
+		for (int32 SegmentIndex = 0; SegmentIndex < 7; SegmentIndex++)
+		{
+			if (Mask & (1 << SegmentIndex))
+			{
+				const FVector4& Segment = ParkourPreview::DigitSegments[SegmentIndex];
+				LabelSegments.Add(FVector4(Segment.X + OffsetX, Segment.Y, Segment.Z + OffsetX, Segment.W));
+			}
+		}
+	}
+
+	Label.NumSegments = LabelSegments.Num() - Label.FirstSegment;
+
+	// Labels turn with the view, bound them by a sphere of their size
+	LocalBounds += FBox::BuildAABB(Label.Location, FVector(FMath::Max(HalfWidth, 1.0f) * LabelSize));
+}
+
+void UParkourPreviewComponent::CommitPreview()
+{
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
+FPrimitiveSceneProxy* UParkourPreviewComponent::CreateSceneProxy()
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_Preview);
+
+	if (Lines.Num() == 0 && Labels.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	return new FParkourPreviewSceneProxy(this);
+}
+
+FBoxSphereBounds UParkourPreviewComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	if (!LocalBounds.IsValid)
+	{
+		return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.0f);
+	}
+
+	return FBoxSphereBounds(LocalBounds).TransformBy(LocalToWorld);
+}
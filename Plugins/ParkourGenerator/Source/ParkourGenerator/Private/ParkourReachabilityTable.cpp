@@ -0,0 +1,165 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourReachabilityTable.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Engine/World.h"
+
+void UParkourReachabilityTable::CopyMovementSettings(const ACharacter* Character)
+{
+	const UCharacterMovementComponent* Movement = Character ? Character->GetCharacterMovement() : nullptr;
+	if (!Movement)
+	{
+		return;
+	}
+
+	Modify();
+
+	GravityScale = Movement->GravityScale;
+	JumpZVelocity = Movement->JumpZVelocity;
+	MaxWalkSpeed = Movement->MaxWalkSpeed;
+	MaxAcceleration = Movement->MaxAcceleration;
+	AirControl = Movement->AirControl;
+	JumpMaxHoldTime = Character->JumpMaxHoldTime;
+
+	// Class defaults have no world, GravityZ is kept then
+	if (const UWorld* World = Character->GetWorld())
+	{
+		GravityZ = World->GetGravityZ();
+	}
+}
+
+void UParkourReachabilityTable::Bake()
+{
+	if (SourceCharacter)
+	{
+		CopyMovementSettings(SourceCharacter->GetDefaultObject<ACharacter>());
+	}
+
+	const float Gravity = GravityZ * GravityScale;
+	if (Gravity >= 0.0f)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Cannot bake %s, gravity has to point down"), *GetName());
+		return;
+	}
+
+	Modify();
+
+	// Simulate a jump from a run-up, integrating like falling character movement
+	TArray<FVector2D> Trajectory;
+	FVector2D Position(0.0f, 0.0f);
+	FVector2D Velocity(MaxWalkSpeed * RunUpSpeedFraction, JumpZVelocity);
+	float Time = 0.0f;
+
+	Trajectory.Add(Position);
+	BakedMaxJumpHeight = 0.0f;
+
+	const int32 MaxSteps = 100000;
+	while (Position.Y >= -MaxDrop && Position.X <= MaxDistance && Trajectory.Num() < MaxSteps)
+	{
+		// Air control accelerates towards the landing, up to walk speed
+		Velocity.X = FMath::Min(Velocity.X + MaxAcceleration * AirControl * SimulationStep, MaxWalkSpeed);
+
+		// Holding jump keeps the jump velocity
+		if (Time >= JumpMaxHoldTime)
+		{
+			Velocity.Y = FMath::Max(Velocity.Y + Gravity * SimulationStep, -TerminalVelocity);
+		}
+
+		Position += Velocity * SimulationStep;
+		Time += SimulationStep;
+
+		Trajectory.Add(Position);
+		BakedMaxJumpHeight = FMath::Max(BakedMaxJumpHeight, (float)Position.Y);
+	}
+
+	// Highest landing at or beyond each sample, the trajectory never moves backwards
+	TArray<float> HighestFrom;
+	HighestFrom.SetNumUninitialized(Trajectory.Num());
+	float Highest = -MAX_flt;
+	for (int32 i = Trajectory.Num() - 1; i >= 0; i--)
+	{
+		Highest = FMath::Max(Highest, (float)Trajectory[i].Y);
+		HighestFrom[i] = Highest;
+	}
+
+	BakedDistanceResolution = DistanceResolution;
+	BakedHeightResolution = HeightResolution;
+	BakedMinHeight = -MaxDrop;
+	NumDistanceSamples = FMath::FloorToInt(MaxDistance / DistanceResolution) + 1;
+	NumHeightSamples = FMath::FloorToInt((MaxRise + MaxDrop) / HeightResolution) + 1;
+	ReachableBits.Init(0, (NumDistanceSamples * NumHeightSamples + 7) / 8);
+	BakedMaxJumpDistance = 0.0f;
+	BakedMaxReach = 0.0f;
+
+	int32 Sample = 0;
+	for (int32 DistanceIndex = 0; DistanceIndex < NumDistanceSamples; DistanceIndex++)
+	{
+		const float Distance = DistanceIndex * DistanceResolution;
+		while (Sample < Trajectory.Num() && Trajectory[Sample].X < Distance)
+		{
+			Sample++;
+		}
+
+		// The character dropped out of the table before getting this far
+		if (Sample == Trajectory.Num())
+		{
+			break;
+		}
+
+		const float MaxHeight = HighestFrom[Sample];
+		if (MaxHeight >= 0.0f)
+		{
+			BakedMaxJumpDistance = Distance;
+		}
+		if (MaxHeight >= BakedMinHeight)
+		{
+			BakedMaxReach = Distance;
+		}
+
+		for (int32 HeightIndex = 0; HeightIndex < NumHeightSamples; HeightIndex++)
+		{
+			if (BakedMinHeight + HeightIndex * HeightResolution > MaxHeight)
+			{
+				break;
+			}
+
+			const int32 Bit = DistanceIndex * NumHeightSamples + HeightIndex;
+			ReachableBits[Bit >> 3] |= 1 << (Bit & 7);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Baked reachability table %s: %.0fcm far (%.0fcm with drops), %.0fcm high"), *GetName(), BakedMaxJumpDistance, BakedMaxReach, BakedMaxJumpHeight);
+}
+
+bool UParkourReachabilityTable::IsReachable(float HorizontalDistance, float HeightDelta) const
+{
+	if (!IsBaked() || HorizontalDistance < 0.0f)
+	{
+		return false;
+	}
+
+	// Reachability only shrinks with distance and height, the farther and higher sample around the query decides
+	const float HeightCell = (HeightDelta - BakedMinHeight) / BakedHeightResolution;
+	if (HeightCell < 0.0f)
+	{
+		return false;
+	}
+
+	const int32 DistanceIndex = FMath::CeilToInt(HorizontalDistance / BakedDistanceResolution);
+	const int32 HeightIndex = FMath::CeilToInt(HeightCell);
+	if (DistanceIndex >= NumDistanceSamples || HeightIndex >= NumHeightSamples)
+	{
+		return false;
+	}
+
+	const int32 Bit = DistanceIndex * NumHeightSamples + HeightIndex;
+	return (ReachableBits[Bit >> 3] >> (Bit & 7)) & 1;
+}
+
+uint32 UParkourReachabilityTable::GetTableHash() const
+{
+	const FVector4 Layout(BakedDistanceResolution, BakedHeightResolution, BakedMinHeight, NumHeightSamples);
+	const uint32 Hash = FCrc::MemCrc32(&Layout, sizeof(FVector4));
+	return FCrc::MemCrc32(ReachableBits.GetData(), ReachableBits.Num(), Hash);
+}
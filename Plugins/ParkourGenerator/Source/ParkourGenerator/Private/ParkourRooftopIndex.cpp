@@ -0,0 +1,86 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourRooftopIndex.h"
+
+void FParkourRooftopIndex::Build(const TArray<FBox>& Buildings, float InCellSize, float EdgeInset)
+{
+	CellSize = FMath::Max(InCellSize, 1.0f);
+	Roofs.Reset(Buildings.Num());
+	Grid.Reset();
+
+	for (const FBox& Building : Buildings)
+	{
+		const FVector2D Min(Building.Min.X + EdgeInset, Building.Min.Y + EdgeInset);
+		const FVector2D Max(Building.Max.X - EdgeInset, Building.Max.Y - EdgeInset);
+		if (Min.X > Max.X || Min.Y > Max.Y)
+		{
+			continue;
+		}
+
+		const int32 RoofIndex = Roofs.Add({FBox2D(Min, Max), (float)Building.Max.Z});
+
+		const FIntPoint MinCell = GetCell(Min);
+		const FIntPoint MaxCell = GetCell(Max);
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				Grid.FindOrAdd(FIntPoint(X, Y)).Add(RoofIndex);
+			}
+		}
+	}
+}
+
+FIntPoint FParkourRooftopIndex::GetCell(const FVector2D& Point) const
+{
+	return FIntPoint(FMath::FloorToInt(Point.X / CellSize), FMath::FloorToInt(Point.Y / CellSize));
+}
+
+bool FParkourRooftopIndex::FindClosestRoofPoint(const FVector& Target, float SearchRadius, float MaxHeightDifference, TFunctionRef<bool(const FVector&)> Accept, FVector& OutPoint) const
+{
+	const FVector2D Target2D(Target.X, Target.Y);
+	const FIntPoint MinCell = GetCell(Target2D - FVector2D(SearchRadius, SearchRadius));
+	const FIntPoint MaxCell = GetCell(Target2D + FVector2D(SearchRadius, SearchRadius));
+
+	float BestDistSq = MAX_flt;
+	bool bFound = false;
+
+	// A roof spanning several cells is visited once per cell, which is cheaper than deduplicating
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			const TArray<int32>* RoofIndices = Grid.Find(FIntPoint(X, Y));
+			if (!RoofIndices)
+			{
+				continue;
+			}
+
+			for (int32 RoofIndex : *RoofIndices)
+			{
+				const FRoof& Roof = Roofs[RoofIndex];
+				if (FMath::Abs(Roof.Height - Target.Z) > MaxHeightDifference)
+				{
+					continue;
+				}
+
+				const FVector2D Closest = Roof.Top.GetClosestPointTo(Target2D);
+				if (FVector2D::DistSquared(Closest, Target2D) > FMath::Square(SearchRadius))
+				{
+					continue;
+				}
+
+				const FVector Candidate(Closest.X, Closest.Y, Roof.Height);
+				const float DistSq = FVector::DistSquared(Candidate, Target);
+				if (DistSq < BestDistSq && Accept(Candidate))
+				{
+					BestDistSq = DistSq;
+					OutPoint = Candidate;
+					bFound = true;
+				}
+			}
+		}
+	}
+
+	return bFound;
+}
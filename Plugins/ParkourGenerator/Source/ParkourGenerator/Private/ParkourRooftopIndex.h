@@ -0,0 +1,41 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Spatial index over the rooftops of generated buildings.
+ *
+ * Every roof is stored as its top rectangle (inset so a player lands fully on it) in a uniform
+ * XY grid, a roof being registered in every cell it overlaps. Queries only look at the cells
+ * around the search point, so snapping a platform costs the same no matter how many buildings
+ * the play area holds.
+ */
+class FParkourRooftopIndex
+{
+public:
+	/** Index the roofs of world-space building boxes, ignoring roofs too small for the inset */
+	void Build(const TArray<FBox>& Buildings, float InCellSize, float EdgeInset);
+
+	bool IsEmpty() const { return Roofs.Num() == 0; }
+
+	/**
+	 * Find the roof point closest to Target within SearchRadius (horizontally) and MaxHeightDifference
+	 * (vertically) that passes the Accept filter. Returns false if there is none.
+	 */
+	bool FindClosestRoofPoint(const FVector& Target, float SearchRadius, float MaxHeightDifference, TFunctionRef<bool(const FVector&)> Accept, FVector& OutPoint) const;
+
+private:
+	struct FRoof
+	{
+		FBox2D Top;
+		float Height;
+	};
+
+	FIntPoint GetCell(const FVector2D& Point) const;
+
+	TArray<FRoof> Roofs;
+	TMap<FIntPoint, TArray<int32>> Grid;
+	float CellSize = 1.0f;
+};
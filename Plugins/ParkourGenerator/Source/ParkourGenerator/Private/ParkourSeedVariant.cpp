@@ -0,0 +1,95 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourSeedVariant.h"
+#include "ParkourPath.h"
+#include "ParkourPlayArea.h"
+#include "ParkourOccupancyGrid.h"
+#include "ParkourLLM.h"
+
+FParkourSeedVariant FParkourSeedVariant::Evaluate(const AParkourPath& Path, const AParkourPlayArea* PlayArea, int32 Seed, const FParkourVariantWeights& Weights, float OccupancyCellSize)
+{
+	LLM_SCOPE_BYTAG(ParkourGenerator_PathSolve);
+
+	FParkourSeedVariant Variant;
+	Variant.Seed = Seed;
+
+	// Rooftop routes land on the current buildings, other paths are solved first and avoided by buildings of the same seed
+	Variant.bSolvedEnvironment = PlayArea && !Path.IsUsingRooftopsOf(PlayArea);
+	if (PlayArea && !Variant.bSolvedEnvironment)
+	{
+		Variant.Buildings = PlayArea->GeneratedBuildingBoxes;
+	}
+
+	Variant.Platforms = Path.SolvePlatforms(Seed, Variant.PlatformsOnRooftop);
+
+	// The variant's own platforms, not the ones the path has generated
+	if (Variant.bSolvedEnvironment)
+	{
+		PlayArea->SolveBuildings(Seed, Variant.Buildings, nullptr, &Variant.Platforms);
+	}
+
+	Variant.NumPlatforms = Variant.Platforms.Num();
+	Variant.NumBuildings = Variant.Buildings.Num();
+
+	// Jump margins
+	const int32 NumJumps = FMath::Max(Variant.NumPlatforms - 1, 0);
+	float MarginSum = 0.0f;
+	float MarginSqSum = 0.0f;
+	Variant.MinJumpMargin = NumJumps > 0 ? 1.0f : 0.0f;
+	for (int32 i = 0; i < NumJumps; i++)
+	{
+		const FVector From = Variant.Platforms[i].GetLocation();
+		const FVector To = Variant.Platforms[i + 1].GetLocation();
+
+		const float Margin = 1.0f - Path.GetJumpDifficulty(From, To);
+		MarginSum += Margin;
+		MarginSqSum += Margin * Margin;
+		Variant.MinJumpMargin = FMath::Min(Variant.MinJumpMargin, Margin);
+
+		if (!Path.IsJumpValid(From, To))
+		{
+			Variant.InvalidJumps++;
+		}
+	}
+
+	if (NumJumps > 0)
+	{
+		Variant.MeanJumpMargin = MarginSum / NumJumps;
+		Variant.JumpMarginDeviation = FMath::Sqrt(FMath::Max(MarginSqSum / NumJumps - FMath::Square(Variant.MeanJumpMargin), 0.0f));
+	}
+
+	// Platform heights
+	if (Variant.NumPlatforms > 0)
+	{
+		double HeightSum = 0.0;
+		double HeightSqSum = 0.0;
+		for (const FTransform& Platform : Variant.Platforms)
+		{
+			HeightSum += Platform.GetLocation().Z;
+			HeightSqSum += FMath::Square(Platform.GetLocation().Z);
+		}
+
+		const double MeanHeight = HeightSum / Variant.NumPlatforms;
+		Variant.HeightDeviation = (float)FMath::Sqrt(FMath::Max(HeightSqSum / Variant.NumPlatforms - MeanHeight * MeanHeight, 0.0));
+	}
+
+	// Clearance against the buildings of this variant
+	if (Variant.NumBuildings > 0 && Variant.NumPlatforms > 0)
+	{
+		FParkourOccupancyGrid Grid;
+		Grid.Build(Path.GetClearanceBounds(Variant.Platforms), OccupancyCellSize, Variant.Buildings);
+
+		TArray<FParkourClearanceIssue> Issues;
+		Path.FindClearanceIssues(Grid, Variant.Platforms, Issues);
+		Variant.BlockedPlatforms = Issues.Num();
+	}
+
+	Variant.Score = Weights.PlatformCount * Variant.NumPlatforms
+		+ Weights.MeanJumpMargin * Variant.MeanJumpMargin
+		+ Weights.JumpMarginDeviation * Variant.JumpMarginDeviation
+		+ Weights.HeightDeviation * Variant.HeightDeviation / 100.0f
+		+ Weights.BlockedPlatform * Variant.BlockedPlatforms
+		+ Weights.InvalidJump * Variant.InvalidJumps;
+
+	return Variant;
+}
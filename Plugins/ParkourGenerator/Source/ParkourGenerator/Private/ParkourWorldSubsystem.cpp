@@ -0,0 +1,325 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourWorldSubsystem.h"
+#include "ParkourPath.h"
+#include "ParkourPlayArea.h"
+#include "ParkourGeneratorSettings.h"
+#include "ParkourNavigationBatch.h"
+#include "Async/Async.h"
+#include "UObject/GarbageCollection.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+
+#if WITH_EDITOR
+#include "LevelEditorViewport.h"
+#endif
+
+void UParkourWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get())
+	{
+		FrameBudgetMs = Settings->TimeSliceBudgetMs;
+	}
+}
+
+int32 UParkourWorldSubsystem::RequestGeneration(AParkourPath* Path, AParkourPlayArea* PlayArea, int32 Seed)
+{
+	if (!Path)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: RequestGeneration needs a path"));
+		return INDEX_NONE;
+	}
+
+	FGenerationRequest& Request = Requests.AddDefaulted_GetRef();
+	Request.Id = NextRequestId++;
+	Request.Path = Path;
+	Request.PlayArea = PlayArea;
+
+	// One seed drives both solves, the environment gets its own stream derived from it
+	Request.PathSeed = Seed != 0 ? Seed : FMath::Rand();
+	Request.EnvironmentSeed = (int32)FRandomStream(Request.PathSeed).GetUnsignedInt();
+
+	// Environment placement queries the path BVH from a worker thread, bring it up to date here
+	if (PlayArea && PlayArea->ParkourPath)
+	{
+		PlayArea->ParkourPath->UpdatePathBVH();
+	}
+
+	// The environment keeps clear of the platforms, unless the path lands on its rooftops
+	if (!PlayArea)
+	{
+		Request.Steps = {EGenerationStep::SolvePath, EGenerationStep::CreateMeshes};
+	}
+	else if (Path->IsUsingRooftopsOf(PlayArea))
+	{
+		Request.Steps = {EGenerationStep::SolveEnvironment, EGenerationStep::SolvePath, EGenerationStep::CreateMeshes};
+	}
+	else
+	{
+		Request.Steps = {EGenerationStep::SolvePath, EGenerationStep::SolveEnvironment, EGenerationStep::CreateMeshes};
+	}
+
+	return Request.Id;
+}
+
+int32 UParkourWorldSubsystem::RequestMeshCreation(AParkourPath* Path, AParkourPlayArea* PlayArea)
+{
+	if (!Path && !PlayArea)
+	{
+		return INDEX_NONE;
+	}
+
+	FGenerationRequest& Request = Requests.AddDefaulted_GetRef();
+	Request.Id = NextRequestId++;
+	Request.Path = Path;
+	Request.PlayArea = PlayArea;
+	Request.Steps = {EGenerationStep::CreateMeshes};
+
+	return Request.Id;
+}
+
+void UParkourWorldSubsystem::CancelGeneration(int32 RequestId)
+{
+	for (int32 i = Requests.Num() - 1; i >= 0; i--)
+	{
+		if (Requests[i].Id != RequestId)
+		{
+			continue;
+		}
+
+		// A running solve still references the actors, it is dropped once it returns
+		if (Requests[i].Solve.IsValid())
+		{
+			Requests[i].bCancelled = true;
+		}
+		else
+		{
+			Requests.RemoveAt(i);
+		}
+	}
+}
+
+void UParkourWorldSubsystem::Deinitialize()
+{
+	for (FGenerationRequest& Request : Requests)
+	{
+		if (Request.Solve.IsValid())
+		{
+			Request.Solve.Wait();
+		}
+	}
+	Requests.Empty();
+
+	if (bNavigationBatchOpen)
+	{
+		FParkourNavigationBatch::End(GetWorld());
+		bNavigationBatchOpen = false;
+	}
+
+	Super::Deinitialize();
+}
+
+void UParkourWorldSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	UParkourWorldSubsystem* This = CastChecked<UParkourWorldSubsystem>(InThis);
+	for (FGenerationRequest& Request : This->Requests)
+	{
+		if (Request.Solve.IsValid())
+		{
+			Collector.AddReferencedObject(Request.SolvePath);
+			Collector.AddReferencedObject(Request.SolvePlayArea);
+		}
+	}
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
+TStatId UParkourWorldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UParkourWorldSubsystem, STATGROUP_Tickables);
+}
+
+void UParkourWorldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Meshes of queued requests are created over many frames, navigation is rebuilt once the queue is empty
+	if (bNavigationBatchOpen != (Requests.Num() > 0))
+	{
+		bNavigationBatchOpen = !bNavigationBatchOpen;
+		bNavigationBatchOpen ? FParkourNavigationBatch::Begin(GetWorld()) : FParkourNavigationBatch::End(GetWorld());
+	}
+
+	const double Deadline = FPlatformTime::Seconds() + FrameBudgetMs / 1000.0;
+
+	while (Requests.Num() > 0)
+	{
+		FGenerationRequest& Request = Requests[0];
+
+		// Drop requests whose actors are gone or that were cancelled while solving
+		const bool bActorsGone = (!Request.Path.IsExplicitlyNull() && !Request.Path.IsValid())
+			|| (!Request.PlayArea.IsExplicitlyNull() && !Request.PlayArea.IsValid());
+		if ((Request.bCancelled || bActorsGone) && (!Request.Solve.IsValid() || Request.Solve.IsReady()))
+		{
+			Requests.RemoveAt(0);
+			continue;
+		}
+
+		const EGenerationStep Step = Request.Steps[Request.CurrentStep];
+		const bool bStepDone = Step == EGenerationStep::CreateMeshes
+			? TickCreateMeshes(Request, Deadline)
+			: TickSolve(Request, Step);
+
+		if (!bStepDone)
+		{
+			return;
+		}
+
+		if (++Request.CurrentStep < Request.Steps.Num())
+		{
+			continue;
+		}
+
+		const int32 FinishedId = Request.Id;
+		Requests.RemoveAt(0);
+		OnGenerationFinished.Broadcast(FinishedId);
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			return;
+		}
+	}
+}
+
+bool UParkourWorldSubsystem::TickSolve(FGenerationRequest& Request, EGenerationStep Step)
+{
+	AParkourPath* Path = Request.Path.Get();
+	AParkourPlayArea* PlayArea = Request.PlayArea.Get();
+
+	if (!Request.Solve.IsValid())
+	{
+		if (Step == EGenerationStep::SolvePath ? !Path : !PlayArea)
+		{
+			Request.bCancelled = true;
+			return false;
+		}
+
+		// Referenced from here on, a collection before the worker holds its guard keeps them as well
+		Request.SolvePath = Path;
+		Request.SolvePlayArea = PlayArea;
+		Request.Result = MakeShared<FSolveResult, ESPMode::ThreadSafe>();
+
+		TSharedPtr<FSolveResult, ESPMode::ThreadSafe> Result = Request.Result;
+		const int32 PathSeed = Request.PathSeed;
+		const int32 EnvironmentSeed = Request.EnvironmentSeed;
+
+		Request.Solve = Async(EAsyncExecution::ThreadPool, [Step, Path, PlayArea, PathSeed, EnvironmentSeed, Result]()
+		{
+			// Solvers only read the actors, no collection may null their references meanwhile
+			FGCScopeGuard GCGuard;
+
+			if (Step == EGenerationStep::SolvePath)
+			{
+				Result->Platforms = Path->SolvePlatforms(PathSeed, Result->PlatformsOnRooftop);
+			}
+			else
+			{
+				PlayArea->SolveBuildings(EnvironmentSeed, Result->Buildings);
+			}
+		});
+
+		return false;
+	}
+
+	if (!Request.Solve.IsReady())
+	{
+		return false;
+	}
+
+	Request.Solve.Reset();
+	Request.SolvePath = nullptr;
+	Request.SolvePlayArea = nullptr;
+
+	// The actors may have been destroyed or the request cancelled while the solve ran
+	if (Request.bCancelled || (Step == EGenerationStep::SolvePath ? !Request.Path.IsValid() : !Request.PlayArea.IsValid()))
+	{
+		Request.bCancelled = true;
+		Request.Result.Reset();
+		return false;
+	}
+
+	// Generated data is only written on the game thread, the meshes follow in time slices
+	if (Step == EGenerationStep::SolvePath)
+	{
+		Path->ApplyPlatformLayoutDeferred(Request.Result->Platforms, Request.PathSeed, Request.Result->PlatformsOnRooftop);
+	}
+	else
+	{
+		PlayArea->ApplyBuildingLayoutDeferred(Request.Result->Buildings, PlayArea->bGenerateFloor, Request.EnvironmentSeed);
+	}
+
+	Request.Result.Reset();
+	return true;
+}
+
+bool UParkourWorldSubsystem::TickCreateMeshes(FGenerationRequest& Request, double Deadline)
+{
+	AParkourPath* Path = Request.Path.Get();
+	AParkourPlayArea* PlayArea = Request.PlayArea.Get();
+
+	// Whatever is closest to the viewer appears first
+	FVector ViewLocation;
+	if (!Request.bMeshesSorted && GetViewLocation(ViewLocation))
+	{
+		if (Path)
+		{
+			Path->SortPendingMeshes(ViewLocation);
+		}
+		if (PlayArea)
+		{
+			PlayArea->SortPendingMeshes(ViewLocation);
+		}
+	}
+	Request.bMeshesSorted = true;
+
+	// At least one mesh per frame, so a tiny budget still makes progress
+	do
+	{
+		const bool bCreated = (Path && Path->CreateNextPendingMesh()) || (PlayArea && PlayArea->CreateNextPendingMesh());
+		if (!bCreated)
+		{
+			return true;
+		}
+	}
+	while (FPlatformTime::Seconds() < Deadline);
+
+	return false;
+}
+
+bool UParkourWorldSubsystem::GetViewLocation(FVector& OutLocation) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+#if WITH_EDITOR
+	if (!World->IsGameWorld() && GCurrentLevelEditingViewportClient)
+	{
+		OutLocation = GCurrentLevelEditingViewportClient->GetViewLocation();
+		return true;
+	}
+#endif
+
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	if (PlayerController && PlayerController->PlayerCameraManager)
+	{
+		OutLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+		return true;
+	}
+
+	return false;
+}
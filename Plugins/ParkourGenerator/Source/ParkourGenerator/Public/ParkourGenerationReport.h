@@ -0,0 +1,146 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "ParkourGenerationReport.generated.h"
+
+class UProceduralMeshComponent;
+
+/** Counters a solve increments, shared by the worker threads of a parallel solve */
+struct FParkourSolveStats
+{
+	/** Spline positions evaluated */
+	std::atomic<int32> SplineSamples{0};
+
+	/** Jumps that failed validation */
+	std::atomic<int32> RejectedJumps{0};
+
+	/** Grid cells left empty by the density roll */
+	std::atomic<int32> RejectedDensity{0};
+
+	/** Buildings outside the area shape */
+	std::atomic<int32> RejectedOutsideArea{0};
+
+	/** Buildings within PathClearance of the path */
+	std::atomic<int32> RejectedPathClearance{0};
+
+	/** Buildings within PathClearance of a generated platform */
+	std::atomic<int32> RejectedPlatformClearance{0};
+};
+
+/**
+ * What one generation cost: wall time per phase, work done by the solver and what it created.
+ * Actors keep the report of their last generation, the editor subsystem sums them up per call.
+ */
+USTRUCT(BlueprintType)
+struct PARKOURGENERATOR_API FParkourGenerationReport
+{
+	GENERATED_BODY()
+
+	/** Actor, or subsystem call for a summed up report */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator")
+	FString Name;
+
+	/** Map the generation ran in, set by the editor subsystem */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator")
+	FString Map;
+
+	/** UTC time the generation finished (ISO 8601) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator")
+	FString Timestamp;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator")
+	int32 Seed = 0;
+
+	/** Generations whose layout came from the generation cache instead of a solve */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator")
+	int32 CacheHits = 0;
+
+	// ========== TIME (ms) ==========
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Time")
+	float SolveTimeMs = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Time")
+	float MeshTimeMs = 0.0f;
+
+	/** Everything, including cache lookups and clearing the previous generation */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Time")
+	float TotalTimeMs = 0.0f;
+
+	// ========== SOLVER ==========
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Solver")
+	int32 SplineSamples = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Solver")
+	int32 RejectedJumps = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Solver")
+	int32 RejectedDensity = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Solver")
+	int32 RejectedOutsideArea = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Solver")
+	int32 RejectedPathClearance = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Solver")
+	int32 RejectedPlatformClearance = 0;
+
+	// ========== OUTPUT ==========
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Output")
+	int32 Platforms = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Output")
+	int32 Buildings = 0;
+
+	/** Mesh components existing when generation returned, incremental generation creates the rest later */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Output")
+	int32 Components = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Output")
+	int32 Triangles = 0;
+
+	/** Change of the process's used physical memory from Start to Finish (MB), negative if more was freed than allocated */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator|Output")
+	float MemoryDeltaMB = 0.0f;
+
+	/** Record the used memory before generation, returns the start time for Finish */
+	double Start();
+
+	/** Add the counters of a solve */
+	void AddSolveStats(const FParkourSolveStats& Stats);
+
+	/** Add the components and triangles of generated meshes */
+	void AddMeshes(const TArray<UProceduralMeshComponent*>& Meshes);
+
+	/** Add the times and counts of another report, e.g. one actor of a batch */
+	void Accumulate(const FParkourGenerationReport& Other);
+
+	/** Set the total time since StartTime, the memory delta since Start and the timestamp */
+	void Finish(double StartTime);
+
+	/** One line JSON object */
+	FString ToJson() const;
+
+	/** CSV row, columns as in GetCsvHeader */
+	FString ToCsvRow() const;
+
+	static FString GetCsvHeader();
+
+	/**
+	 * Append to a .json (one object per line) or .csv file (header written when the file is new), so costs
+	 * can be tracked over time. Relative paths are relative to the project directory.
+	 */
+	bool AppendToFile(const FString& FilePath) const;
+
+	/** Milliseconds since StartTime (FPlatformTime::Seconds) */
+	static float MillisecondsSince(double StartTime) { return (float)((FPlatformTime::Seconds() - StartTime) * 1000.0); }
+
+private:
+	uint64 StartUsedPhysical = 0;
+};
@@ -5,16 +5,11 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+/** Runtime module: generator actors, solvers and the world subsystem. Editor tooling lives in ParkourGeneratorEditor */
 class FParkourGeneratorModule : public IModuleInterface
 {
 public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
-
-private:
-	void RegisterMenuExtensions();
-	void UnregisterMenuExtensions();
-
-	TSharedPtr<class FUICommandList> PluginCommands;
 };
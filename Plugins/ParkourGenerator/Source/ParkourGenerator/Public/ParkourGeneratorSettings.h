@@ -11,8 +11,9 @@
  *
  * Configure default values for the Parkour Generator tool.
  * Access via Project Settings -> Plugins -> Parkour Generator
+ * Saved to DefaultGame.ini, packaged games read the runtime values (e.g. the time slice budget) from there
  */
-UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Parkour Generator"))
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Parkour Generator"))
 class PARKOURGENERATOR_API UParkourGeneratorSettings : public UDeveloperSettings
 {
 	GENERATED_BODY()
@@ -58,6 +59,53 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Default Environment Settings", meta = (ClampMin = "100.0"))
 	float DefaultPathClearance = 500.0f;
 
+	// ========== GENERATION CACHE ==========
+
+	/** Cache solved layouts of fixed-seed paths and areas in the Derived Data Cache, keyed by a hash of their inputs */
+	UPROPERTY(config, EditAnywhere, Category = "Generation Cache")
+	bool bUseGenerationCache = true;
+
+	// ========== GENERATION REPORTS ==========
+
+	/**
+	 * File the editor subsystem's Generate* calls append their report to: .csv for CSV, anything else for one
+	 * JSON object per line. Relative to the project directory, empty to not write reports
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Generation Reports")
+	FString GenerationReportFile;
+
+	// ========== PREVIEW ==========
+
+	/**
+	 * While a path is being edited interactively (slider and spline point drags), its preview only shows the
+	 * spline and coarse platform markers. The full solve runs once the change is committed or no change came
+	 * in for this long (s)
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Preview", meta = (ClampMin = "0.0"))
+	float PreviewDebounceSeconds = 0.25f;
+
+	// ========== CLEARANCE ==========
+
+	/** Voxel size of the occupancy grid clearance checks run on, enlarged automatically for huge levels (cm) */
+	UPROPERTY(config, EditAnywhere, Category = "Clearance", meta = (ClampMin = "5.0"))
+	float OccupancyCellSize = 25.0f;
+
+	// ========== TIME SLICING ==========
+
+	/** Game thread time incremental generation may use per frame (ms) */
+	UPROPERTY(config, EditAnywhere, Category = "Time Slicing", meta = (ClampMin = "0.1"))
+	float TimeSliceBudgetMs = 2.0f;
+
+	// ========== BAKE SETTINGS ==========
+
+	/** Content folder that baked static mesh assets are written to, a long package path such as /Game/Baked */
+	UPROPERTY(config, EditAnywhere, Category = "Bake Settings")
+	FString BakedAssetPath = TEXT("/Game/ParkourGenerator/Baked");
+
+	/** Size of the grid chunks that environment geometry is merged into when baking (cm) */
+	UPROPERTY(config, EditAnywhere, Category = "Bake Settings", meta = (ClampMin = "1000.0"))
+	float BakeChunkSize = 5000.0f;
+
 	// ========== PRESETS ==========
 
 	/** Preset: Character can jump 150cm high, 350cm far (realistic) */
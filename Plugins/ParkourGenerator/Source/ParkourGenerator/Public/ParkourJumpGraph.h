@@ -0,0 +1,142 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ParkourJumpGraph.generated.h"
+
+class AParkourPath;
+
+/** What a route search minimizes */
+UENUM(BlueprintType)
+enum class EParkourRouteMetric : uint8
+{
+	/** Total travelled distance */
+	Shortest UMETA(DisplayName = "Shortest"),
+	/** Jumps far below the jump limits, even if that takes more of them */
+	Safest UMETA(DisplayName = "Safest")
+};
+
+/** A route through the jump graph */
+USTRUCT(BlueprintType)
+struct PARKOURGENERATOR_API FParkourRoute
+{
+	GENERATED_BODY()
+
+	/** Indices into GeneratedPlatformTransforms, start to goal */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	TArray<int32> PlatformIndices;
+
+	/** Summed travel distance (cm) */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	float Length = 0.0f;
+
+	/** Summed squared jump difficulty (0 = trivial, 1 = at the safe limit per jump) */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	float Risk = 0.0f;
+
+	bool IsValid() const { return PlatformIndices.Num() > 0; }
+};
+
+/** A jump that skips over platforms of the generated chain */
+USTRUCT(BlueprintType)
+struct PARKOURGENERATOR_API FParkourShortcut
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	int32 FromIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	int32 ToIndex = INDEX_NONE;
+
+	/** Number of chain platforms the jump skips */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	int32 SkippedPlatforms = 0;
+};
+
+/** Level flow analysis of a generated path */
+USTRUCT(BlueprintType)
+struct PARKOURGENERATOR_API FParkourRouteAnalysis
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	int32 NumPlatforms = 0;
+
+	/** Number of valid jumps between any two platforms */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	int32 NumJumps = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	FParkourRoute ShortestRoute;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	FParkourRoute SafestRoute;
+
+	/** Shortest routes that avoid the jumps of the routes before them */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	TArray<FParkourRoute> AlternateRoutes;
+
+	/** Farthest forward jump from each platform that skips part of the chain */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	TArray<FParkourShortcut> Shortcuts;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	float BuildTimeMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	float QueryTimeMs = 0.0f;
+};
+
+/**
+ * Jump Graph
+ *
+ * Directed graph over all platforms of a path with an edge for every jump that is valid under the
+ * path's jump parameters, not only between chain neighbours. Candidate pairs come from a uniform grid
+ * with cells as large as the jump reach, so building it is linear in the number of platforms.
+ * Edges are stored in compressed rows for cache friendly searches.
+ */
+class PARKOURGENERATOR_API FParkourJumpGraph
+{
+public:
+	struct FEdge
+	{
+		int32 To;
+		/** Straight-line distance of the jump */
+		float Distance;
+		/** Difficulty of the jump, 0 = trivial, 1 = at the safe limit */
+		float Difficulty;
+	};
+
+	/** Build the graph for the given platform transforms */
+	void Build(const AParkourPath& Path, const TArray<FTransform>& Platforms);
+
+	int32 NumNodes() const { return Positions.Num(); }
+	int32 NumEdges() const { return Edges.Num(); }
+
+	/** Outgoing jumps of a platform */
+	TArrayView<const FEdge> GetEdges(int32 Node) const
+	{
+		return TArrayView<const FEdge>(Edges.GetData() + EdgeOffsets[Node], EdgeOffsets[Node + 1] - EdgeOffsets[Node]);
+	}
+
+	/** A* (Shortest) or Dijkstra (Safest) search, returns false if Goal cannot be reached */
+	bool FindRoute(int32 Start, int32 Goal, EParkourRouteMetric Metric, FParkourRoute& OutRoute) const;
+
+	/** Up to MaxRoutes distinct shortest routes, each one penalizing the jumps used by the previous ones */
+	void FindAlternateRoutes(int32 Start, int32 Goal, int32 MaxRoutes, TArray<FParkourRoute>& OutRoutes) const;
+
+	/** For each platform, the farthest forward jump that skips at least MinSkipped chain platforms */
+	void FindShortcuts(int32 MinSkipped, TArray<FParkourShortcut>& OutShortcuts) const;
+
+private:
+	/** Search with optional per-edge cost multipliers (indexed like Edges) */
+	bool FindRouteInternal(int32 Start, int32 Goal, EParkourRouteMetric Metric, const TArray<float>* EdgePenalties, FParkourRoute& OutRoute) const;
+
+	float GetEdgeCost(const FEdge& Edge, EParkourRouteMetric Metric) const;
+
+	TArray<FVector> Positions;
+	TArray<int32> EdgeOffsets;
+	TArray<FEdge> Edges;
+};
@@ -0,0 +1,40 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AParkourPath;
+
+/**
+ * Cached validity of the jumps along a platform chain.
+ *
+ * Jump i goes from platform i to i + 1. An update compares the chain with the one validated last: the
+ * platforms matching at the start and at the end keep the results of their jumps, only the dirty range
+ * in between is validated again. A change of the jump parameters dirties every jump.
+ */
+class PARKOURGENERATOR_API FParkourJumpValidation
+{
+public:
+	/** Validate the jumps of Platforms that changed since the last update, returns the number of jumps validated */
+	int32 Update(const AParkourPath& Path, const TArray<FTransform>& Platforms);
+
+	/** Forget all results, the next update validates every jump */
+	void Reset();
+
+	int32 NumJumps() const { return ValidJumps.Num(); }
+
+	bool IsJumpValid(int32 JumpIndex) const { return ValidJumps[JumpIndex]; }
+
+	/** Indices of the jumps that failed, in order */
+	const TArray<int32>& GetInvalidJumps() const { return InvalidJumps; }
+
+private:
+	/** Hash of everything IsJumpValid depends on besides the end points */
+	static uint32 GetParameterHash(const AParkourPath& Path);
+
+	TArray<FVector> Locations;
+	TBitArray<> ValidJumps;
+	TArray<int32> InvalidJumps;
+	uint32 ParameterHash = 0;
+};
@@ -0,0 +1,128 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ParkourLayout.generated.h"
+
+/** Broadcast by paths and play areas once all meshes of a generation exist */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnParkourGenerationCompleted);
+
+/** How generated geometry is stored in the level */
+UENUM(BlueprintType)
+enum class EParkourLayoutStorage : uint8
+{
+	MeshComponents UMETA(DisplayName = "Mesh Components"),
+	CompactLayout UMETA(DisplayName = "Compact Layout (Rebuild On Load)")
+};
+
+/**
+ * Quantized platform transform.
+ * Location on a 1 mm grid, pitch/yaw as 16-bit angles, uniform XY scale in 1/1000 steps.
+ */
+USTRUCT()
+struct PARKOURGENERATOR_API FParkourPlatformRecord
+{
+	GENERATED_BODY()
+
+	/** Location in millimeters */
+	UPROPERTY()
+	FIntVector Location = FIntVector::ZeroValue;
+
+	UPROPERTY()
+	uint16 Pitch = 0;
+
+	UPROPERTY()
+	uint16 Yaw = 0;
+
+	/** XY scale in 1/1000 */
+	UPROPERTY()
+	uint16 Scale = 1000;
+
+	static FParkourPlatformRecord FromTransform(const FTransform& Transform);
+	FTransform ToTransform() const;
+};
+
+/** Quantized building box (bottom-center location and size, both in millimeters) */
+USTRUCT()
+struct PARKOURGENERATOR_API FParkourBuildingRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FIntVector Location = FIntVector::ZeroValue;
+
+	UPROPERTY()
+	FIntVector Size = FIntVector::ZeroValue;
+
+	static FParkourBuildingRecord FromBox(const FBox& Box);
+	FBox ToBox() const;
+};
+
+/**
+ * Compact layout record
+ *
+ * Everything needed to rebuild generated geometry deterministically, at a small fraction
+ * of the size of the procedural mesh components it replaces in the level.
+ */
+USTRUCT()
+struct PARKOURGENERATOR_API FParkourCompactLayout
+{
+	GENERATED_BODY()
+
+	/** Seed the layout was generated with */
+	UPROPERTY(VisibleAnywhere, Category = "Layout")
+	int32 Seed = 0;
+
+	UPROPERTY()
+	TArray<FParkourPlatformRecord> Platforms;
+
+	/** Platform transforms at full precision, kept instead of Platforms when the layout is not quantized */
+	UPROPERTY()
+	TArray<FTransform> ExactPlatforms;
+
+	/** Indices of platforms that are building roofs and have no mesh of their own */
+	UPROPERTY()
+	TArray<int32> RooftopPlatforms;
+
+	UPROPERTY()
+	TArray<FParkourBuildingRecord> Buildings;
+
+	/** Building boxes at full precision, kept instead of Buildings when the layout is not quantized */
+	UPROPERTY()
+	TArray<FBox> ExactBuildings;
+
+	/** Whether a floor was generated with the buildings */
+	UPROPERTY()
+	bool bFloor = false;
+
+	void Reset();
+
+	/** Quantize only for storage that needs the compact record, otherwise transforms are kept as generated */
+	void SetPlatforms(const TArray<FTransform>& Transforms, bool bQuantize = true);
+	void GetPlatforms(TArray<FTransform>& OutTransforms) const;
+
+	void SetRooftopPlatforms(const TArray<bool>& OnRooftop);
+	void GetRooftopPlatforms(TArray<bool>& OutOnRooftop) const;
+
+	void SetBuildings(const TArray<FBox>& Boxes, bool bQuantize = true);
+	void GetBuildings(TArray<FBox>& OutBoxes) const;
+
+	/**
+	 * 64-bit hash of the platforms, rooftop platforms and buildings, not of the seed or the floor flag. Taken
+	 * over the quantized records (full precision layouts are quantized for it), so it does not depend on storage
+	 */
+	uint64 GetFingerprint() const;
+
+	/** Fingerprint of a layout that is not recorded (e.g. solved without components) */
+	static uint64 MakeFingerprint(const TArray<FTransform>& Platforms, const TArray<bool>& OnRooftop, const TArray<FBox>& Buildings);
+
+	/** Fingerprint as 16 hex digits */
+	static FString FingerprintToString(uint64 Fingerprint) { return FString::Printf(TEXT("%016llx"), Fingerprint); }
+
+	/** Object flags for generated components under the given storage mode (transient components are not saved) */
+	static EObjectFlags GetComponentFlags(EParkourLayoutStorage Storage)
+	{
+		return Storage == EParkourLayoutStorage::CompactLayout ? RF_Transient : RF_NoFlags;
+	}
+};
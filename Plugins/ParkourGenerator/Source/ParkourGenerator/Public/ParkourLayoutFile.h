@@ -0,0 +1,169 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Parkour Layout File (.pklayout)
+ *
+ * Versioned, flat binary exchange format for generated layouts. The file is a fixed size header
+ * followed by arrays of fixed size records. Everything is little endian, 4-byte floats, and every
+ * section starts on a 16-byte boundary, so a memory mapped file can be read in place without parsing.
+ *
+ * Layout:
+ *   FParkourLayoutFileHeader
+ *   FParkourLayoutFilePlatform[Platforms.Count]
+ *   FParkourLayoutFileBuilding[Buildings.Count]
+ *   FParkourLayoutFilePathSample[PathSamples.Count]
+ *
+ * Readers must use Section.Offset and Section.Stride rather than assuming the records are packed,
+ * newer versions may append fields to the end of a record.
+ */
+namespace ParkourLayoutFile
+{
+	/** 'PKLY' */
+	static constexpr uint32 Magic = 0x594C4B50;
+
+	/** Current format version */
+	static constexpr uint32 Version = 1;
+
+	/** Alignment of every section */
+	static constexpr uint32 SectionAlignment = 16;
+
+	/** Distance between exported path samples (cm) */
+	static constexpr float PathSampleInterval = 100.0f;
+}
+
+/** Location of one record array in the file */
+struct FParkourLayoutFileSection
+{
+	/** Byte offset from the start of the file */
+	uint64 Offset;
+
+	/** Number of records */
+	uint32 Count;
+
+	/** Size of one record in bytes */
+	uint32 Stride;
+};
+
+/** Generation parameters of the layout */
+struct FParkourLayoutFileParams
+{
+	float MaxJumpHeight;
+	float MaxJumpDistance;
+	float JumpSafetyMargin;
+	float PlatformWidth;
+	float PlatformDepth;
+	float PlatformThickness;
+	int32 PathSeed;
+	int32 EnvironmentSeed;
+	float AreaDimensions[3];
+	float PathClearance;
+	float BuildingDensity;
+	/** EParkourAreaShape */
+	uint8 AreaShape;
+	/** EParkourEnvironmentStyle */
+	uint8 EnvironmentStyle;
+	/** Bit 0: play area present, bit 1: floor generated */
+	uint8 Flags;
+	uint8 Reserved;
+	uint32 ReservedWords[2];
+};
+
+struct FParkourLayoutFileHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 HeaderSize;
+	uint32 Reserved;
+	uint64 FileSize;
+	uint64 Reserved2;
+	FParkourLayoutFileParams Params;
+	FParkourLayoutFileSection Platforms;
+	FParkourLayoutFileSection Buildings;
+	FParkourLayoutFileSection PathSamples;
+};
+
+/**
+ * World-space platform. Location is the walkable top center, Size is (depth, width, thickness) after scale.
+ * A thickness of 0 marks a building roof the route lands on, which has no platform geometry.
+ */
+struct FParkourLayoutFilePlatform
+{
+	float Location[3];
+	float Rotation[4];
+	float Size[3];
+};
+
+/** World-space axis aligned building box */
+struct FParkourLayoutFileBuilding
+{
+	float Min[3];
+	float Max[3];
+};
+
+/** World-space point on the path spline */
+struct FParkourLayoutFilePathSample
+{
+	float Location[3];
+	float Distance;
+};
+
+static_assert(sizeof(FParkourLayoutFileSection) == 16, "Layout file section size changed");
+static_assert(sizeof(FParkourLayoutFileParams) == 64, "Layout file params size changed");
+static_assert(sizeof(FParkourLayoutFileHeader) == 144, "Layout file header size changed");
+static_assert(sizeof(FParkourLayoutFileHeader) % ParkourLayoutFile::SectionAlignment == 0, "Layout file header must keep sections aligned");
+static_assert(sizeof(FParkourLayoutFilePlatform) == 40, "Layout file platform size changed");
+static_assert(sizeof(FParkourLayoutFileBuilding) == 24, "Layout file building size changed");
+static_assert(sizeof(FParkourLayoutFilePathSample) == 16, "Layout file path sample size changed");
+
+/**
+ * Zero-copy view of a layout file in memory (typically a memory mapped file).
+ * Validates the header and section bounds once, after that all access is direct pointer arithmetic.
+ */
+class PARKOURGENERATOR_API FParkourLayoutView
+{
+public:
+	/** Returns false if Data is not a valid layout file of a supported version */
+	bool Initialize(const uint8* InData, int64 InSize);
+
+	bool IsValid() const { return Header != nullptr; }
+
+	const FParkourLayoutFileHeader& GetHeader() const { check(Header); return *Header; }
+
+	int32 NumPlatforms() const { return Header ? Header->Platforms.Count : 0; }
+	int32 NumBuildings() const { return Header ? Header->Buildings.Count : 0; }
+	int32 NumPathSamples() const { return Header ? Header->PathSamples.Count : 0; }
+
+	const FParkourLayoutFilePlatform& GetPlatform(int32 Index) const { return GetRecord<FParkourLayoutFilePlatform>(Header->Platforms, Index); }
+	const FParkourLayoutFileBuilding& GetBuilding(int32 Index) const { return GetRecord<FParkourLayoutFileBuilding>(Header->Buildings, Index); }
+	const FParkourLayoutFilePathSample& GetPathSample(int32 Index) const { return GetRecord<FParkourLayoutFilePathSample>(Header->PathSamples, Index); }
+
+private:
+	template<typename RecordType>
+	const RecordType& GetRecord(const FParkourLayoutFileSection& Section, int32 Index) const
+	{
+		check(Index >= 0 && (uint32)Index < Section.Count);
+		return *reinterpret_cast<const RecordType*>(Data + Section.Offset + (uint64)Index * Section.Stride);
+	}
+
+	static bool IsSectionValid(const FParkourLayoutFileSection& Section, uint32 MinStride, int64 DataSize);
+
+	const uint8* Data = nullptr;
+	const FParkourLayoutFileHeader* Header = nullptr;
+};
+
+/** Builds a layout file in memory */
+class PARKOURGENERATOR_API FParkourLayoutWriter
+{
+public:
+	static void Write(
+		const FParkourLayoutFileParams& Params,
+		TArrayView<const FParkourLayoutFilePlatform> Platforms,
+		TArrayView<const FParkourLayoutFileBuilding> Buildings,
+		TArrayView<const FParkourLayoutFilePathSample> PathSamples,
+		TArray<uint8>& OutData
+	);
+};
@@ -0,0 +1,39 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+class UPrimitiveComponent;
+
+/**
+ * Batches the navigation updates of generation.
+ *
+ * Every generated component with collision dirties the navmesh on its own, so generating a map would rebuild
+ * the same tiles over and over. While a batch is open navigation building is locked and the bounds of the
+ * components created and destroyed are collected. Closing it unlocks building and dirties their union once.
+ * Batches nest per world, only the outermost one locks and flushes. Game thread only.
+ */
+class PARKOURGENERATOR_API FParkourNavigationBatch
+{
+public:
+	/** Batch for the lifetime of the scope */
+	explicit FParkourNavigationBatch(UWorld* InWorld) : World(InWorld) { Begin(World); }
+	~FParkourNavigationBatch() { End(World); }
+
+	FParkourNavigationBatch(const FParkourNavigationBatch&) = delete;
+	FParkourNavigationBatch& operator=(const FParkourNavigationBatch&) = delete;
+
+	/** Open a batch, for batches spanning frames (e.g. time-sliced mesh creation) */
+	static void Begin(UWorld* World);
+
+	/** Close a batch opened with Begin */
+	static void End(UWorld* World);
+
+	/** Add the bounds of a component about to be destroyed or just created, if its world has a batch open */
+	static void AddDirtyComponent(const UPrimitiveComponent* Component);
+
+private:
+	UWorld* World;
+};
@@ -0,0 +1,83 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ParkourOccupancyGrid.generated.h"
+
+/** Space around a platform that has to be free of geometry */
+UENUM(BlueprintType)
+enum class EParkourClearanceCheck : uint8
+{
+	/** Standing height above the platform top */
+	Headroom UMETA(DisplayName = "Headroom"),
+	/** Headroom around the platform, for jumps that land short or long */
+	LandingZone UMETA(DisplayName = "Landing Zone"),
+	/** Corridor from the previous platform, where the player runs and jumps */
+	RunUp UMETA(DisplayName = "Run-Up")
+};
+
+/** A platform whose clearance is blocked */
+USTRUCT(BlueprintType)
+struct PARKOURGENERATOR_API FParkourClearanceIssue
+{
+	GENERATED_BODY()
+
+	/** Index of the platform in the checked chain, for RunUp the platform jumped to */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	int32 PlatformIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	EParkourClearanceCheck Check = EParkourClearanceCheck::Headroom;
+
+	/** Center of the first occupied cell found */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	FVector BlockedLocation = FVector::ZeroVector;
+};
+
+/**
+ * Occupancy Grid
+ *
+ * One bit per voxel over a region of the level, set where generated geometry is. A cell counts as occupied
+ * when its center lies inside a box, so queries are accurate to half a cell and boxes that merely touch a
+ * query (a platform standing on a roof) do not block it. Every cell costs one bit test, a query costs the
+ * number of cells it covers no matter how many boxes were added.
+ */
+class PARKOURGENERATOR_API FParkourOccupancyGrid
+{
+public:
+	/** Cells are doubled in size until the grid needs at most this many bits (8 MB) */
+	static constexpr int64 MaxCells = 1ll << 26;
+
+	/** Voxelize the boxes over Bounds, geometry outside of Bounds is ignored */
+	void Build(const FBox& InBounds, float InCellSize, const TArray<FBox>& Occupied);
+
+	bool IsEmpty() const { return Cells.Num() == 0; }
+
+	/** Cell size after Build, larger than requested for big bounds */
+	float GetCellSize() const { return CellSize; }
+
+	bool IsOccupied(const FVector& Point) const;
+
+	/**
+	 * Whether no occupied cell has its center inside Box, the same rule Build uses, so a box resting on occupied
+	 * geometry (headroom above a roof) is free. OutBlocked is set to the center of the first occupied cell
+	 */
+	bool IsBoxFree(const FBox& Box, FVector* OutBlocked = nullptr) const;
+
+	/** Whether the space HalfWidth to the sides of and Height above a segment is free, swept one cell at a time */
+	bool IsCorridorFree(const FVector& Start, const FVector& End, float HalfWidth, float Height, FVector* OutBlocked = nullptr) const;
+
+private:
+	/** Cells whose centers lie inside Box, or that overlap it, clamped to the grid. False if there are none */
+	bool GetCellRange(const FBox& Box, bool bCentersInside, FIntVector& OutMin, FIntVector& OutMax) const;
+
+	int32 GetIndex(int32 X, int32 Y, int32 Z) const { return X + Dims.X * (Y + Dims.Y * Z); }
+
+	FVector GetCellCenter(int32 X, int32 Y, int32 Z) const { return Bounds.Min + (FVector(X, Y, Z) + 0.5f) * CellSize; }
+
+	FBox Bounds = FBox(ForceInit);
+	FIntVector Dims = FIntVector::ZeroValue;
+	float CellSize = 1.0f;
+	TBitArray<> Cells;
+};
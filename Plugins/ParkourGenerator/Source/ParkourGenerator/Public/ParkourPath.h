@@ -5,9 +5,30 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Components/SplineComponent.h"
+#include "ParkourLayout.h"
+#include "ParkourPathBVH.h"
+#include "ParkourGenerationReport.h"
+#include "ParkourOccupancyGrid.h"
+#include "ParkourJumpValidation.h"
 #include "ParkourPath.generated.h"
 
 class UProceduralMeshComponent;
+class UStaticMeshComponent;
+class UPrimitiveComponent;
+class AParkourPlayArea;
+class FParkourRooftopIndex;
+class UParkourPreviewComponent;
+class UParkourReachabilityTable;
+
+/** How platforms are spaced along the spline */
+UENUM(BlueprintType)
+enum class EParkourPlacementMode : uint8
+{
+	/** Step forward by the safe jump distance, patching jumps that fail with intermediate platforms */
+	Greedy UMETA(DisplayName = "Greedy"),
+	/** Choose among candidates along the whole spline, minimizing the platform count under the jump constraints */
+	Optimal UMETA(DisplayName = "Optimal")
+};
 
 /**
  * Parkour Path Actor
@@ -27,6 +48,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Path")
 	USplineComponent* PathSpline;
 
+	/** Editor only preview of the platform solve */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Path")
+	UParkourPreviewComponent* PreviewComponent;
+
 	// ========== JUMP PARAMETERS ==========
 
 	/** Maximum height the player can jump (in Unreal units, cm) */
@@ -41,6 +66,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Jump Parameters", meta = (ClampMin = "0.5", ClampMax = "1.0"))
 	float JumpSafetyMargin = 0.85f;
 
+	/**
+	 * Reachability baked from the character's movement. When set and baked, jumps are validated against it
+	 * and its jump distance and height replace MaxJumpDistance and MaxJumpHeight
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Jump Parameters")
+	UParkourReachabilityTable* ReachabilityTable = nullptr;
+
 	// ========== PLATFORM SETTINGS ==========
 
 	/** Default platform width */
@@ -77,6 +109,55 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Variation")
 	int32 RandomSeed = 0;
 
+	// ========== PLACEMENT ==========
+
+	/** Greedy placement, or a global optimum over candidate positions (building rooftops are only used by Greedy) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Placement")
+	EParkourPlacementMode PlacementMode = EParkourPlacementMode::Greedy;
+
+	/** Distance between candidate platform positions along the spline (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Placement", meta = (EditCondition = "PlacementMode == EParkourPlacementMode::Optimal", ClampMin = "5.0"))
+	float OptimizerSampleSpacing = 25.0f;
+
+	/**
+	 * 0 minimizes the platform count only. Higher values accept extra platforms to keep every jump close to
+	 * OptimizerTargetDifficulty
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Placement", meta = (EditCondition = "PlacementMode == EParkourPlacementMode::Optimal", ClampMin = "0.0"))
+	float OptimizerEvenness = 0.0f;
+
+	/** Jump difficulty the optimizer aims for (0 = trivial, 1 = at the safe limit) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Placement", meta = (EditCondition = "PlacementMode == EParkourPlacementMode::Optimal", ClampMin = "0.0", ClampMax = "1.0"))
+	float OptimizerTargetDifficulty = 0.8f;
+
+	// ========== ROOFTOPS ==========
+
+	/** Land on the roofs of generated buildings where one is in reach, instead of spawning a floating platform */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Rooftops")
+	bool bUseBuildingRooftops = false;
+
+	/** Play area whose generated buildings provide the rooftops (generate its environment before the path) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Rooftops", meta = (EditCondition = "bUseBuildingRooftops"))
+	AParkourPlayArea* RooftopSourceArea = nullptr;
+
+	/** How far (cm) a platform may move off the path to land on a roof */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Rooftops", meta = (EditCondition = "bUseBuildingRooftops", ClampMin = "0.0"))
+	float RooftopSearchRadius = 300.0f;
+
+	// ========== CLEARANCE ==========
+
+	/** Free height the player needs above platforms and along run-ups (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Clearance", meta = (ClampMin = "50.0"))
+	float HeadroomHeight = 200.0f;
+
+	/** Headroom needed around a landing platform, for jumps that land short or long (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Clearance", meta = (ClampMin = "0.0"))
+	float LandingMargin = 50.0f;
+
+	/** Width of the corridor from one platform to the next that has to be free (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Clearance", meta = (ClampMin = "10.0"))
+	float RunUpWidth = 80.0f;
+
 	// ========== VISUALIZATION ==========
 
 	/** Show debug visualization of jump arcs */
@@ -87,16 +168,77 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Debug")
 	bool bShowPlatformPreview = true;
 
+	// ========== STREAMING ==========
+
+	/**
+	 * Endless route: starting at the first spline point, platforms are generated ahead of the streaming
+	 * target under the jump constraints and recycled behind it. Starts on BeginPlay.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Streaming")
+	bool bStreamingMode = false;
+
+	/** Actor the route is extended for, the first player pawn if not set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Streaming", meta = (EditCondition = "bStreamingMode"))
+	AActor* StreamingTarget = nullptr;
+
+	/** Number of platform components in the ring buffer, all created on warm-up */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Streaming", meta = (EditCondition = "bStreamingMode", ClampMin = "4", ClampMax = "256"))
+	int32 StreamingBufferSize = 32;
+
+	/** How far ahead of the target the route is kept generated (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Streaming", meta = (EditCondition = "bStreamingMode", ClampMin = "500.0"))
+	float StreamingLookAhead = 4000.0f;
+
+	/** Maximum change of heading between two jumps (degrees) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Streaming", meta = (EditCondition = "bStreamingMode", ClampMin = "0.0", ClampMax = "90.0"))
+	float StreamingMaxTurnAngle = 25.0f;
+
+	/** Height change per jump as a fraction of the safe jump height */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Streaming", meta = (EditCondition = "bStreamingMode", ClampMin = "0.0", ClampMax = "1.0"))
+	float StreamingHeightVariation = 0.5f;
+
+	// ========== TIME SLICING ==========
+
+	/** Create platform meshes across frames within the time slice budget, nearest to the camera first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Time Slicing")
+	bool bIncrementalGeneration = false;
+
+	/** Broadcast once all platform meshes of a generation exist */
+	UPROPERTY(BlueprintAssignable, Category = "Parkour Generator")
+	FOnParkourGenerationCompleted OnGenerationCompleted;
+
+	// ========== STORAGE ==========
+
+	/** How generated platforms are saved with the level. Compact Layout saves only the layout record and rebuilds meshes on load */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Storage")
+	EParkourLayoutStorage LayoutStorage = EParkourLayoutStorage::MeshComponents;
+
 	// ========== GENERATED DATA ==========
 
-	/** Array of generated platform locations */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour|Generated")
+	/** Array of generated platform locations (restored from CompactLayout on load) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Parkour|Generated")
 	TArray<FTransform> GeneratedPlatformTransforms;
 
+	/** Per generated platform, whether it is a building roof rather than a spawned platform (no mesh) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Parkour|Generated")
+	TArray<bool> GeneratedPlatformOnRooftop;
+
+	/** Seed and platform transforms of the last generation (quantized only in Compact Layout storage), this is what gets saved */
+	UPROPERTY(VisibleAnywhere, Category = "Parkour|Generated")
+	FParkourCompactLayout CompactLayout;
+
+	/** Cost of the last GenerateParkour */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Parkour|Generated")
+	FParkourGenerationReport LastGenerationReport;
+
 	/** Array of spawned platform meshes */
 	UPROPERTY()
 	TArray<UProceduralMeshComponent*> GeneratedPlatformMeshes;
 
+	/** Static mesh components that replaced the platform meshes after baking */
+	UPROPERTY()
+	TArray<UStaticMeshComponent*> BakedPlatformMeshes;
+
 	// ========== FUNCTIONS ==========
 
 	/** Generate platforms along the path */
@@ -107,38 +249,224 @@ public:
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
 	void ClearGeneratedParkour();
 
+	/** Replace the generated platforms with an existing layout (e.g. an imported one) without solving */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator", meta = (AutoCreateRefTerm = "PlatformsOnRooftop"))
+	void ApplyPlatformLayout(const TArray<FTransform>& PlatformTransforms, int32 Seed, const TArray<bool>& PlatformsOnRooftop);
+
+	/** Fingerprint of the generated platforms (16 hex digits), equal for equal layouts at storage precision */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	FString GetLayoutFingerprint() const { return FParkourCompactLayout::FingerprintToString(CompactLayout.GetFingerprint()); }
+
+	/**
+	 * Solve platform transforms for a seed without touching components or generated data.
+	 * Safe to call off the game thread while neither the path nor its rooftop source area is edited.
+	 * Stats, if given, counts the work done.
+	 */
+	TArray<FTransform> SolvePlatforms(int32 Seed, TArray<bool>& OutOnRooftop, FParkourSolveStats* Stats = nullptr) const;
+
+	/** Like ApplyPlatformLayout, but only queues the meshes for CreateNextPendingMesh */
+	void ApplyPlatformLayoutDeferred(const TArray<FTransform>& PlatformTransforms, int32 Seed, const TArray<bool>& PlatformsOnRooftop);
+
+	/** Destroy the next component of the replaced layout or create the next queued platform mesh, returns false once both queues are empty */
+	bool CreateNextPendingMesh();
+
+	bool HasPendingMeshes() const { return PendingRemovals.Num() > 0 || NextPendingMesh < PendingMeshes.Num(); }
+
+	/** Reorder the queued meshes so the ones closest to ViewLocation are created first */
+	void SortPendingMeshes(const FVector& ViewLocation);
+
+	/** Whether rooftops of the source area's buildings are used for this path */
+	bool IsUsingRooftopsOf(const AParkourPlayArea* PlayArea) const { return bUseBuildingRooftops && PlayArea && RooftopSourceArea == PlayArea; }
+
+#if WITH_EDITOR
+	/** Bake the generated platforms into one static mesh asset with simple collision */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
+	void BakeToStaticMesh();
+#endif
+
+	/** Warm up the ring buffer and start extending the route ahead of Target (the first player pawn if null) */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void StartStreaming(AActor* Target);
+
+	/** Stop extending the route, the streamed platforms stay where they are */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void StopStreaming();
+
+	/** Total number of platforms streamed since StartStreaming */
+	UFUNCTION(BlueprintPure, Category = "Parkour Generator")
+	int64 GetStreamedPlatformCount() const { return StreamedPlatformCount; }
+
 	/** Validate jump between two points */
 	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
 	bool IsJumpValid(const FVector& FromPoint, const FVector& ToPoint) const;
 
 	/** Get safe jump distance considering margin */
 	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
-	float GetSafeJumpDistance() const { return MaxJumpDistance * JumpSafetyMargin; }
+	float GetSafeJumpDistance() const;
 
 	/** Get safe jump height considering margin */
 	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
-	float GetSafeJumpHeight() const { return MaxJumpHeight * JumpSafetyMargin; }
+	float GetSafeJumpHeight() const;
+
+	/** Farthest horizontal distance of any valid jump, beyond GetSafeJumpDistance for drops a reachability table allows */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	float GetMaxJumpReach() const;
+
+	/** Whether jumps are validated against a baked ReachabilityTable */
+	bool UsesReachabilityTable() const;
+
+	/** How hard a jump is relative to the safe limits (0 = trivial, 1 = at the limit) */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	float GetJumpDifficulty(const FVector& FromPoint, const FVector& ToPoint) const;
+
+	/** Exact distance from a point to the path spline */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	float GetDistanceToPath(const FVector& Point) const { return PathBVH.GetDistance(Point); }
+
+	/**
+	 * Check the headroom, landing zone and run-up of every platform of a chain (e.g. GeneratedPlatformTransforms)
+	 * against an occupancy grid, reporting at most one issue per platform. Returns true if all are free
+	 */
+	bool FindClearanceIssues(const FParkourOccupancyGrid& Grid, const TArray<FTransform>& Platforms, TArray<FParkourClearanceIssue>& OutIssues) const;
+
+	/** World bounds of the space the clearance checks of a platform chain look at, empty without platforms */
+	FBox GetClearanceBounds(const TArray<FTransform>& Platforms) const;
+
+	/**
+	 * Validity of the jumps between generated platforms. Only jumps whose platforms moved or whose jump
+	 * parameters changed since the last call are validated again
+	 */
+	const FParkourJumpValidation& UpdateJumpValidation();
+
+	/** Segment BVH of the path spline, for exact proximity queries */
+	const FParkourPathBVH& GetPathBVH() const { return PathBVH; }
+
+	/** Rebuild the path BVH from the spline. Done on construction and before solves that query it */
+	void UpdatePathBVH();
+
+	virtual void Tick(float DeltaTime) override;
 
 protected:
 	virtual void BeginPlay() override;
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void PostLoad() override;
+	virtual void PostRegisterAllComponents() override;
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 
 private:
+	/** Space above a platform's top, grown by Margin to the sides */
+	FBox GetPlatformClearanceBox(const FTransform& Platform, float Margin) const;
+
 	/** Calculate platform positions along spline */
-	TArray<FTransform> CalculatePlatformPositions();
+	TArray<FTransform> CalculatePlatformPositions(FRandomStream& RandomStream, TArray<bool>& OutOnRooftop, FParkourSolveStats* Stats) const;
+
+	/**
+	 * Dynamic program over candidates every OptimizerSampleSpacing along the spline: the cheapest chain of valid
+	 * jumps from start to end, each jump costing one platform plus the evenness term. Returns false if the end
+	 * cannot be reached
+	 */
+	bool CalculateOptimalPlatformPositions(FRandomStream& RandomStream, TArray<FTransform>& OutPlatforms, FParkourSolveStats* Stats) const;
 
 	/** Add intermediate platforms if jump is too far */
-	void AddIntermediatePlatforms(TArray<FTransform>& Platforms, const FTransform& From, const FTransform& To);
+	void AddIntermediatePlatforms(FRandomStream& RandomStream, TArray<FTransform>& Platforms, TArray<bool>& OnRooftop, const FTransform& From, const FTransform& To, const FParkourRooftopIndex* Rooftops) const;
+
+	/** Move Location onto the closest roof in reach of From, returns false if there is none */
+	bool SnapToRooftop(const FParkourRooftopIndex& Rooftops, const FVector& From, FVector& InOutLocation) const;
+
+	/** Create the box section of a platform mesh, centered on the component */
+	void CreatePlatformGeometry(UProceduralMeshComponent* PlatformMesh, float Width, float Depth, float Thickness) const;
 
 	/** Create a platform mesh at the given transform */
 	UProceduralMeshComponent* CreatePlatformMesh(const FTransform& PlatformTransform, int32 Index);
 
+	/** Create meshes for all GeneratedPlatformTransforms */
+	void CreatePlatformMeshes();
+
+	/** Queue meshes for all GeneratedPlatformTransforms that are not rooftops */
+	void QueuePlatformMeshes();
+
+	/** Like ClearGeneratedParkour, but the generated components are queued for CreateNextPendingMesh to destroy */
+	void QueueGeneratedRemoval();
+
+	/** Create the queued meshes now, or across frames if bIncrementalGeneration is set */
+	void CommitPlatformMeshes();
+
+	/** Mark or unmark generated components transient to match LayoutStorage */
+	void ApplyLayoutStorage();
+
 	/** Update preview visualization */
 	void UpdatePreview();
 
-	FRandomStream RandomStream;
+	/** Preview of the spline and platform markers every safe jump distance along it, without solving */
+	void UpdateCoarsePreview();
+
+	/** Coarse preview while edits keep coming in, the full one once they are committed or settle */
+	void RequestPreviewUpdate();
+
+	/** Extend the streamed route ahead of the target and recycle platforms behind it */
+	void UpdateStreaming();
+
+	/** Next platform of the streamed route after the newest one */
+	FTransform MakeNextStreamedPlatform();
+
+	/** Move a pooled component onto a streamed platform transform */
+	void PlaceStreamedPlatform(UProceduralMeshComponent* PlatformMesh, const FTransform& PlatformTransform) const;
+
+	/** Destroy the ring buffer components */
+	void DestroyStreamingBuffer();
+
+	/** Platform indices whose meshes are still to be created, and the next one to create */
+	TArray<int32> PendingMeshes;
+	int32 NextPendingMesh = 0;
+
+	/** Components of a replaced layout, destroyed before the queued meshes are created */
+	UPROPERTY(Transient)
+	TArray<UPrimitiveComponent*> PendingRemovals;
+
+	/** Platform transforms of levels saved before the compact record, moved to CompactLayout on load */
+	UPROPERTY()
+	TArray<FTransform> GeneratedPlatformTransforms_DEPRECATED;
+
+	/** Set while queued meshes are being created, OnGenerationCompleted fires when it clears */
+	bool bMeshCreationActive = false;
+
+	/** Ring buffer of streamed platforms, oldest at StreamingHead. Sized once on warm-up */
+	UPROPERTY(Transient)
+	TArray<UProceduralMeshComponent*> StreamingPlatformMeshes;
+
+	TArray<FTransform> StreamingPlatformTransforms;
+	int32 StreamingHead = 0;
+	int32 StreamingCount = 0;
+
+	/** Sequence number of the oldest platform in the buffer and total platforms streamed */
+	int64 StreamingFirstSequence = 0;
+	int64 StreamedPlatformCount = 0;
+
+	/** Heading of the streamed route (yaw, degrees) */
+	float StreamingHeading = 0.0f;
+
+	FRandomStream StreamingRandom;
+
+	/** Set on load when meshes have to be rebuilt from CompactLayout once components are registered */
+	bool bLayoutRebuildPending = false;
+
+	FParkourPathBVH PathBVH;
+
+	/** Cached jump validity of GeneratedPlatformTransforms */
+	FParkourJumpValidation JumpValidation;
+
+#if WITH_EDITOR
+	/** Cached jump validity of the preview solve, so edits only validate the jumps they changed */
+	FParkourJumpValidation PreviewJumpValidation;
+
+	/** Change type of the property edit in progress, Unspecified outside PostEditChangeProperty */
+	EPropertyChangeType::Type PreviewChangeType = EPropertyChangeType::Unspecified;
+
+	/** Time of the last preview request, and the timer running the full preview once edits settle */
+	double LastPreviewRequestTime = 0.0;
+	FTimerHandle PreviewDebounceTimer;
+#endif
 };
@@ -0,0 +1,62 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/**
+ * Bounding volume hierarchy over the linearized segments of a path.
+ *
+ * Distances are measured to the segments themselves rather than to samples along the spline, so nothing
+ * can slip between two samples on a sharp curve. Every node bounds its segments with an AABB and
+ * queries only descend into nodes that can still matter, which keeps them logarithmic in path length.
+ */
+class PARKOURGENERATOR_API FParkourPathBVH
+{
+public:
+	/**
+	 * Build over a spline, linearized to within Tolerance (cm) of the curve. Segments longer than
+	 * MaxSegmentLength are split so height tests along sloped stretches stay tight.
+	 */
+	void Build(const USplineComponent& Spline, float Tolerance, float MaxSegmentLength);
+
+	/** Build over the segments of a world space polyline */
+	void Build(const TArray<FVector>& InPoints, float MaxSegmentLength);
+
+	bool IsEmpty() const { return Segments.Num() == 0; }
+
+	/** The polyline of the last build, before long segments were split */
+	const TArray<FVector>& GetPoints() const { return Points; }
+
+	/** Exact distance from Point to the closest segment, MAX_flt if empty */
+	float GetDistance(const FVector& Point, FVector* OutClosestPoint = nullptr) const;
+
+	/**
+	 * Whether a segment passes within Clearance of a horizontal footprint, measured in XY. Segments lying
+	 * entirely at or above BelowHeight are ignored (e.g. a route running over a building roof).
+	 */
+	bool OverlapsFootprint(const FBox2D& Footprint, float Clearance, float BelowHeight = MAX_flt) const;
+
+private:
+	struct FSegment
+	{
+		FVector Start;
+		FVector End;
+	};
+
+	/** Leaves hold NumSegments segments from First, inner nodes (NumSegments == 0) their children at First and First + 1 */
+	struct FNode
+	{
+		FBox Bounds;
+		int32 First;
+		int32 NumSegments;
+	};
+
+	void BuildNode(int32 NodeIndex, int32 First, int32 Num);
+
+	TArray<FVector> Points;
+	TArray<FSegment> Segments;
+	TArray<FNode> Nodes;
+};
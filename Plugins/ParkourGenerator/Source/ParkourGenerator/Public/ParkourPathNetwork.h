@@ -0,0 +1,95 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ParkourGenerationReport.h"
+#include "ParkourPathNetwork.generated.h"
+
+class AParkourPath;
+
+/** A platform shared by several branches of a network */
+USTRUCT(BlueprintType)
+struct PARKOURGENERATOR_API FParkourJunction
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator")
+	FVector Location = FVector::ZeroVector;
+
+	/** Branch that owns the junction platform */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator")
+	int32 OwnerBranch = INDEX_NONE;
+
+	/** Branches that start or end at the junction */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Parkour Generator")
+	TArray<int32> Branches;
+};
+
+/**
+ * Parkour Path Network
+ *
+ * Joins several paths into one network with junctions, alternate branches and loops. Branch ends that meet
+ * (within JunctionRadius) share one junction platform, and a branch ending on another branch's route joins
+ * it at that branch's closest platform. Branches are solved independently on worker threads, the junctions
+ * are reconciled afterwards, so big hubs are not solved serially as one long spline.
+ */
+UCLASS(Blueprintable, BlueprintType)
+class PARKOURGENERATOR_API AParkourPathNetwork : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AParkourPathNetwork();
+
+	/** Paths making up the network, each keeps its own jump and platform settings */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Network")
+	TArray<AParkourPath*> Branches;
+
+	/** Branch ends this close to each other or to another branch's route form a junction (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Network", meta = (ClampMin = "10.0"))
+	float JunctionRadius = 150.0f;
+
+	/** Seed for branches without their own RandomSeed (0 = random each time) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Network")
+	int32 NetworkSeed = 0;
+
+	/** Junctions found by the last generation */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Parkour Network")
+	TArray<FParkourJunction> Junctions;
+
+	/** Cost of the last GenerateNetwork, over all branches */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Parkour Network")
+	FParkourGenerationReport LastGenerationReport;
+
+	/** Solve all branches in parallel, reconcile the junctions and create the platforms */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
+	void GenerateNetwork();
+
+	/** Clear the platforms of all branches */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
+	void ClearNetwork();
+
+	/** Whether Path is one of the branches */
+	bool ContainsBranch(const AParkourPath* Path) const { return Path && Branches.Contains(Path); }
+
+	/** Whether any branch lands on building rooftops, so the environment has to be generated first */
+	bool UsesRooftops() const;
+
+private:
+	/** Whether a branch can be solved */
+	bool IsBranchValid(int32 BranchIndex) const;
+
+	/** Cluster branch ends into junctions */
+	void FindJunctions();
+
+	/** Share junction platforms between the solved branches, bridging jumps to a junction that are not valid */
+	void ReconcileJunctions(TArray<TArray<FTransform>>& Platforms, TArray<TArray<bool>>& OnRooftop) const;
+
+	/** Evenly spaced platforms between From and To (both excluded) so every jump is valid for Branch, false if none are found */
+	static bool MakeBridge(const AParkourPath& Branch, const FVector& From, const FVector& To, TArray<FTransform>& OutBridge);
+
+	/** Per junction, the branch ends meeting there as BranchIndex * 2 + (0 = start, 1 = end) */
+	TArray<TArray<int32>> JunctionEnds;
+};
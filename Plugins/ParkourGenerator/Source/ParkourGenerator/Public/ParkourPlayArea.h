@@ -6,10 +6,15 @@
 #include "GameFramework/Actor.h"
 #include "Components/BoxComponent.h"
 #include "Components/SplineComponent.h"
+#include "ParkourLayout.h"
+#include "ParkourGenerationReport.h"
 #include "ParkourPlayArea.generated.h"
 
 class UProceduralMeshComponent;
+class UStaticMeshComponent;
+class UPrimitiveComponent;
 class AParkourPath;
+class UParkourPreviewComponent;
 
 /** Type of area shape */
 UENUM(BlueprintType)
@@ -58,6 +63,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Play Area|Shape")
 	USplineComponent* CustomBoundsSpline;
 
+	/** Editor only outline of L and U shapes */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Play Area|Shape")
+	UParkourPreviewComponent* PreviewComponent;
+
 	/** Area dimensions for box/L/U shapes (X=Length, Y=Width, Z=Height) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Play Area|Shape", meta = (ClampMin = "100.0"))
 	FVector AreaDimensions = FVector(5000.0f, 5000.0f, 2000.0f);
@@ -110,6 +119,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Play Area|Floor", meta = (EditCondition = "bGenerateFloor"))
 	float FloorOffset = 0.0f;
 
+	/** Size of the floor tiles, which are clipped to the area shape (Custom shapes are followed at tile resolution) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Play Area|Floor", meta = (EditCondition = "bGenerateFloor", ClampMin = "100.0"))
+	float FloorTileSize = 1000.0f;
+
+	/** Floor tiles are merged into one mesh per chunk of this size, so the floor is culled and streamed in parts (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Play Area|Floor", meta = (EditCondition = "bGenerateFloor", ClampMin = "1000.0"))
+	float FloorChunkSize = 5000.0f;
+
 	// ========== VISUALIZATION ==========
 
 	/** Show bounds visualization */
@@ -120,15 +137,47 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Play Area|Debug")
 	bool bShowEnvironmentPreview = false;
 
+	// ========== TIME SLICING ==========
+
+	/** Create environment meshes across frames within the time slice budget, nearest to the camera first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Play Area|Time Slicing")
+	bool bIncrementalGeneration = false;
+
+	/** Broadcast once all environment meshes of a generation exist */
+	UPROPERTY(BlueprintAssignable, Category = "Parkour Generator")
+	FOnParkourGenerationCompleted OnGenerationCompleted;
+
+	// ========== STORAGE ==========
+
+	/** How generated geometry is saved with the level. Compact Layout saves only the layout record and rebuilds meshes on load */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Play Area|Storage")
+	EParkourLayoutStorage LayoutStorage = EParkourLayoutStorage::MeshComponents;
+
 	// ========== GENERATED DATA ==========
 
+	/** World-space boxes of the generated buildings (restored from CompactLayout on load) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Play Area|Generated")
+	TArray<FBox> GeneratedBuildingBoxes;
+
+	/** Seed and building boxes of the last generation (quantized only in Compact Layout storage), this is what gets saved */
+	UPROPERTY(VisibleAnywhere, Category = "Play Area|Generated")
+	FParkourCompactLayout CompactLayout;
+
+	/** Cost of the last GenerateEnvironment */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "Play Area|Generated")
+	FParkourGenerationReport LastGenerationReport;
+
 	/** Generated building meshes */
 	UPROPERTY()
 	TArray<UProceduralMeshComponent*> GeneratedBuildingMeshes;
 
-	/** Generated floor mesh */
+	/** Generated floor meshes, one per chunk */
+	UPROPERTY()
+	TArray<UProceduralMeshComponent*> GeneratedFloorMeshes;
+
+	/** Static mesh components (one per chunk) that replaced the environment meshes after baking */
 	UPROPERTY()
-	UProceduralMeshComponent* GeneratedFloorMesh;
+	TArray<UStaticMeshComponent*> BakedEnvironmentMeshes;
 
 	// ========== FUNCTIONS ==========
 
@@ -136,10 +185,45 @@ public:
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
 	void GenerateEnvironment();
 
+	/**
+	 * Update the environment after the path or its platforms were edited. Only buildings near the parts that
+	 * changed are checked again: those now within PathClearance are removed, those the old path kept out of
+	 * their cells are added, all other buildings keep their meshes. The result is the same as generating again
+	 * with the same seed. Generates from scratch when the area settings or the seed changed
+	 */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
+	void UpdateEnvironmentForPath();
+
 	/** Clear all generated environment */
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
 	void ClearGeneratedEnvironment();
 
+	/** Replace the generated environment with existing building boxes (e.g. an imported layout) without solving */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void ApplyBuildingLayout(const TArray<FBox>& BuildingBoxes, bool bWithFloor, int32 Seed);
+
+	/** Fingerprint of the generated buildings (16 hex digits), equal for equal layouts at storage precision */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	FString GetLayoutFingerprint() const { return FParkourCompactLayout::FingerprintToString(CompactLayout.GetFingerprint()); }
+
+	/**
+	 * Solve building boxes for a seed without touching components or generated data.
+	 * Safe to call off the game thread while neither the area nor its path is edited.
+	 * Stats, if given, counts the work done. Platforms, if given, are avoided instead of the path's generated platforms.
+	 */
+	void SolveBuildings(int32 Seed, TArray<FBox>& OutBuildings, FParkourSolveStats* Stats = nullptr, const TArray<FTransform>* Platforms = nullptr) const;
+
+	/** Like ApplyBuildingLayout, but only queues the meshes for CreateNextPendingMesh */
+	void ApplyBuildingLayoutDeferred(const TArray<FBox>& BuildingBoxes, bool bWithFloor, int32 Seed);
+
+	/** Destroy the next component of the replaced layout or create the next queued environment mesh (floor first), returns false once all queues are empty */
+	bool CreateNextPendingMesh();
+
+	bool HasPendingMeshes() const { return PendingRemovals.Num() > 0 || NextPendingFloorChunk < PendingFloorChunks.Num() || NextPendingMesh < PendingMeshes.Num(); }
+
+	/** Reorder the queued building meshes so the ones closest to ViewLocation are created first */
+	void SortPendingMeshes(const FVector& ViewLocation);
+
 	/** Generate everything (platforms + environment) */
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
 	void GenerateAll();
@@ -148,6 +232,12 @@ public:
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
 	void ClearAll();
 
+#if WITH_EDITOR
+	/** Bake the generated environment into static mesh assets, merged per chunk, with simple collision */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
+	void BakeToStaticMeshes();
+#endif
+
 	/** Check if a point is within the play area */
 	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
 	bool IsPointInPlayArea(const FVector& Point) const;
@@ -158,33 +248,122 @@ public:
 
 protected:
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void PostLoad() override;
+	virtual void PostRegisterAllComponents() override;
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 
 private:
+	/** A building the solver rolled for a cell before the path checks, and whether it passed them */
+	struct FBuildingCandidate
+	{
+		FBox Box;
+		bool bAccepted = false;
+	};
+
 	/** Update bounds visualization */
 	void UpdateBoundsVisualization();
 
+	/**
+	 * Visit the cells of a grid over the area in tiles on worker threads. Each tile draws from a stream seeded
+	 * with Seed and its coordinates and the results are appended in tile order, so the output is the same for
+	 * any thread count. PlaceInCell may only read the actors. Returns the number of accepted candidates.
+	 */
+	int32 PlaceOnGridTiles(int32 Seed, float GridCellSize, TFunctionRef<bool(FRandomStream&, const FVector&, FBuildingCandidate&)> PlaceInCell, TArray<FBuildingCandidate>& OutCandidates) const;
+
 	/** Generate buildings for urban style */
-	void GenerateUrbanBuildings(FRandomStream& RandomStream);
+	void GenerateUrbanBuildings(int32 Seed, TArray<FBuildingCandidate>& OutCandidates, FParkourSolveStats* Stats, const TArray<FTransform>& Platforms) const;
 
 	/** Generate structures for industrial style */
-	void GenerateIndustrialStructures(FRandomStream& RandomStream);
+	void GenerateIndustrialStructures(int32 Seed, TArray<FBuildingCandidate>& OutCandidates, FParkourSolveStats* Stats, const TArray<FTransform>& Platforms) const;
 
 	/** Generate abstract blockout */
-	void GenerateAbstractBlockout(FRandomStream& RandomStream);
+	void GenerateAbstractBlockout(FRandomStream& RandomStream, TArray<FBuildingCandidate>& OutCandidates, FParkourSolveStats* Stats, const TArray<FTransform>& Platforms) const;
+
+	/**
+	 * Like SolveBuildings, but keeps the candidates that failed the path checks. The random rolls do not depend
+	 * on the path, so a candidate only changes state when the path near it changes
+	 */
+	void SolveBuildingCandidates(int32 Seed, TArray<FBuildingCandidate>& OutCandidates, FParkourSolveStats* Stats, const TArray<FTransform>* Platforms = nullptr) const;
+
+	/** Hash of everything besides the path and its platforms that decides the candidates and their checks */
+	uint32 GetCandidateInputHash(int32 Seed) const;
+
+	/** Keep candidates for UpdateEnvironmentForPath, with the path and platforms they were checked against */
+	void RecordCandidates(TArray<FBuildingCandidate>&& Candidates, int32 Seed);
+
+	/** Check again the candidates within PathClearance of a path stretch or platform that changed since they were recorded, returns the number checked */
+	int32 RecheckCandidates(FParkourSolveStats& Stats);
 
 	/** Create a building mesh */
 	UProceduralMeshComponent* CreateBuildingMesh(const FVector& Location, const FVector& Size, int32 Index);
 
-	/** Create floor mesh */
-	void CreateFloorMesh();
+	/** Create building meshes for all GeneratedBuildingBoxes (and the floor if recorded) */
+	void CreateEnvironmentMeshes();
+
+	/** Queue meshes for all GeneratedBuildingBoxes (and the floor if recorded) */
+	void QueueEnvironmentMeshes();
+
+	/** Like ClearGeneratedEnvironment, but the generated components are queued for CreateNextPendingMesh to destroy */
+	void QueueGeneratedRemoval();
+
+	/** Queue and create the meshes now, or across frames if bIncrementalGeneration is set */
+	void CommitEnvironmentMeshes();
+
+	/** Create the queued meshes now, or across frames if bIncrementalGeneration is set */
+	void CreateQueuedMeshes();
+
+	/** Mark or unmark generated components transient to match LayoutStorage */
+	void ApplyLayoutStorage();
+
+	/** Building box from its bottom-center location and size */
+	static FBox MakeBuildingBox(const FVector& Location, const FVector& Size);
 
-	/** Check if building placement is valid (not blocking path) */
-	bool IsPlacementValid(const FVector& Location, const FVector& Size) const;
+	/** Floor tiles in actor space, clipped to the area shape and grouped by chunk */
+	void BuildFloorChunks(TArray<TArray<FBox2D>>& OutChunks) const;
+
+	/** Create the mesh of one floor chunk, pivoted at the chunk's center */
+	UProceduralMeshComponent* CreateFloorChunkMesh(const TArray<FBox2D>& Tiles, int32 ChunkIndex);
+
+	/** Check if building placement is valid (not blocking the path or Platforms), counting the rule that rejected it in Stats */
+	bool IsPlacementValid(const FVector& Location, const FVector& Size, const TArray<FTransform>& Platforms, FParkourSolveStats* Stats = nullptr) const;
 
 	/** Get area bounds as box */
 	FBox GetAreaBounds() const;
+
+	/** Set on load when meshes have to be rebuilt from CompactLayout once components are registered */
+	bool bLayoutRebuildPending = false;
+
+	/** Building indices whose meshes are still to be created, and the next one to create */
+	TArray<int32> PendingMeshes;
+	int32 NextPendingMesh = 0;
+
+	/** Mesh of each of GeneratedBuildingBoxes by index, set as they are created. Not saved, empty after load */
+	TArray<TWeakObjectPtr<UProceduralMeshComponent>> BuildingMeshes;
+
+	/** Candidates of the last solve in solve order, the accepted ones are GeneratedBuildingBoxes. Not saved */
+	TArray<FBuildingCandidate> BuildingCandidates;
+
+	/** Linearized path and platform locations BuildingCandidates were last checked against */
+	TArray<FVector> CandidatePathPoints;
+	TArray<FVector> CandidatePlatforms;
+
+	uint32 CandidateInputHash = 0;
+
+	/** Floor chunks still to be created, created before the buildings */
+	TArray<TArray<FBox2D>> PendingFloorChunks;
+	int32 NextPendingFloorChunk = 0;
+
+	/** Components of a replaced layout, destroyed before the queued meshes are created */
+	UPROPERTY(Transient)
+	TArray<UPrimitiveComponent*> PendingRemovals;
+
+	/** Single floor quad of levels saved before the floor was tiled, moved to GeneratedFloorMeshes on load */
+	UPROPERTY()
+	UProceduralMeshComponent* GeneratedFloorMesh_DEPRECATED = nullptr;
+
+	/** Set while queued meshes are being created, OnGenerationCompleted fires when it clears */
+	bool bMeshCreationActive = false;
 };
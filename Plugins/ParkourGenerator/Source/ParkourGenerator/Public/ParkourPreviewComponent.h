@@ -0,0 +1,87 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "ParkourPreviewComponent.generated.h"
+
+/**
+ * Editor preview of a solve (platform boxes, jump arcs, platform numbers).
+ *
+ * All geometry is kept as batched lines in its own scene proxy, so drawing a preview costs nothing on
+ * the game thread and nothing goes through the global line batcher. Numbers are drawn as line digits
+ * facing the view instead of debug strings. The proxy is only recreated when the preview changes.
+ */
+UCLASS(ClassGroup = (ParkourGenerator), meta = (BlueprintSpawnableComponent))
+class PARKOURGENERATOR_API UParkourPreviewComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+public:
+	UParkourPreviewComponent();
+
+	/** A preview line in component space */
+	struct FLine
+	{
+		FVector Start;
+		FVector End;
+		FColor Color;
+		float Thickness;
+	};
+
+	/** A number drawn as line digits, Segments index into LabelSegments */
+	struct FLabel
+	{
+		FVector Location;
+		FColor Color;
+		int32 FirstSegment;
+		int32 NumSegments;
+	};
+
+	/** Height of label digits (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour|Debug", meta = (ClampMin = "1.0"))
+	float LabelSize = 20.0f;
+
+	/**
+	 * Start a new preview for a solve identified by SourceHash. Returns false if the current preview already
+	 * shows that solve, in which case nothing has to be added.
+	 */
+	bool BeginPreview(uint32 SourceHash);
+
+	/** Remove all preview geometry */
+	void ClearPreview();
+
+	/** Add a world space line */
+	void AddLine(const FVector& Start, const FVector& End, const FColor& Color, float Thickness);
+
+	/** Add a world space box outline */
+	void AddBox(const FVector& Center, const FVector& Extent, const FQuat& Rotation, const FColor& Color, float Thickness);
+
+	/** Add a world space number label */
+	void AddLabel(const FVector& Location, int32 Number, const FColor& Color);
+
+	/** Send the added geometry to the renderer */
+	void CommitPreview();
+
+	const TArray<FLine>& GetLines() const { return Lines; }
+	const TArray<FLabel>& GetLabels() const { return Labels; }
+
+	/** Digit segments in label space, X right and Y up in units of half the digit height */
+	const TArray<FVector4>& GetLabelSegments() const { return LabelSegments; }
+
+	// UPrimitiveComponent
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+
+private:
+	TArray<FLine> Lines;
+	TArray<FLabel> Labels;
+	TArray<FVector4> LabelSegments;
+
+	/** Component space bounds of all lines and labels */
+	FBox LocalBounds;
+
+	uint32 PreviewHash = 0;
+	bool bHasPreview = false;
+};
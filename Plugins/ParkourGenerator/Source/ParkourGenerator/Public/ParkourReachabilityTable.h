@@ -0,0 +1,137 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ParkourReachabilityTable.generated.h"
+
+class ACharacter;
+
+/**
+ * Parkour Reachability Table
+ *
+ * Which jumps a character can make, baked per character profile from an offline simulation of its
+ * character movement (gravity, jump velocity, air control, walk speed). The result is a 2D table over
+ * horizontal distance and height difference, so validating a jump is a single lookup instead of a
+ * movement simulation or a guess from two thresholds.
+ */
+UCLASS(BlueprintType)
+class PARKOURGENERATOR_API UParkourReachabilityTable : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// ========== MOVEMENT ==========
+
+	/** Character whose movement settings are copied before baking, leave empty to enter them by hand */
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	TSubclassOf<ACharacter> SourceCharacter;
+
+	/** World gravity (cm/s^2), scaled by GravityScale */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
+	float GravityZ = -980.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.01"))
+	float GravityScale = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0"))
+	float JumpZVelocity = 420.0f;
+
+	/** How long holding jump keeps the jump velocity (s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0"))
+	float JumpMaxHoldTime = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0"))
+	float MaxWalkSpeed = 600.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0"))
+	float MaxAcceleration = 2048.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float AirControl = 0.05f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0"))
+	float TerminalVelocity = 4000.0f;
+
+	/** Horizontal speed at take-off as a fraction of MaxWalkSpeed, air control accelerates from there */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float RunUpSpeedFraction = 1.0f;
+
+	// ========== TABLE ==========
+
+	/** Farthest horizontal distance covered by the table (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Table", meta = (ClampMin = "100.0"))
+	float MaxDistance = 1500.0f;
+
+	/** Highest jump up covered by the table (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Table", meta = (ClampMin = "50.0"))
+	float MaxRise = 500.0f;
+
+	/** Deepest drop that is still considered safe (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Table", meta = (ClampMin = "0.0"))
+	float MaxDrop = 1000.0f;
+
+	/** Table cell size along distance and height (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Table", meta = (ClampMin = "1.0"))
+	float DistanceResolution = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Table", meta = (ClampMin = "1.0"))
+	float HeightResolution = 10.0f;
+
+	/** Simulation time step (s) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Table", meta = (ClampMin = "0.001", ClampMax = "0.1"))
+	float SimulationStep = 1.0f / 120.0f;
+
+	// ========== BAKED ==========
+
+	/** Farthest jump to the same height */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Baked")
+	float BakedMaxJumpDistance = 0.0f;
+
+	/** Apex of the jump */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Baked")
+	float BakedMaxJumpHeight = 0.0f;
+
+	/** Farthest jump to any landing height in the table, drops down to MaxDrop included */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Baked")
+	float BakedMaxReach = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Baked")
+	int32 NumDistanceSamples = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Baked")
+	int32 NumHeightSamples = 0;
+
+	/** Simulate the movement model and rebuild the table */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Parkour Generator")
+	void Bake();
+
+	/** Copy gravity, jump and walk settings from a character and its movement component */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void CopyMovementSettings(const ACharacter* Character);
+
+	/** Whether a jump over HorizontalDistance to a HeightDelta higher (negative = lower) landing can be made */
+	UFUNCTION(BlueprintPure, Category = "Parkour Generator")
+	bool IsReachable(float HorizontalDistance, float HeightDelta) const;
+
+	bool IsBaked() const { return ReachableBits.Num() > 0; }
+
+	/** Hash of the baked table, changes whenever a rebake changes any lookup */
+	uint32 GetTableHash() const;
+
+private:
+	/** One bit per (distance, height) sample, distance major, height from BakedMinHeight upwards */
+	UPROPERTY()
+	TArray<uint8> ReachableBits;
+
+	/** Table layout at bake time, so editing the table settings does not shift lookups before a rebake */
+	UPROPERTY()
+	float BakedDistanceResolution = 1.0f;
+
+	UPROPERTY()
+	float BakedHeightResolution = 1.0f;
+
+	UPROPERTY()
+	float BakedMinHeight = 0.0f;
+};
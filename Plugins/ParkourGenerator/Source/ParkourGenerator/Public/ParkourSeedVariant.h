@@ -0,0 +1,99 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ParkourSeedVariant.generated.h"
+
+class AParkourPath;
+class AParkourPlayArea;
+
+/** How the metrics of a seed variant add up to its score, higher scores are better */
+USTRUCT(BlueprintType)
+struct PARKOURGENERATOR_API FParkourVariantWeights
+{
+	GENERATED_BODY()
+
+	/** Per platform, negative to prefer routes with fewer platforms */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Generator")
+	float PlatformCount = -0.02f;
+
+	/** Mean jump margin (1 = trivial jumps, 0 = all at the safe limit) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Generator")
+	float MeanJumpMargin = 1.0f;
+
+	/** Standard deviation of the jump margins, negative to prefer evenly hard jumps */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Generator")
+	float JumpMarginDeviation = -1.0f;
+
+	/** Standard deviation of the platform heights per meter, positive to prefer routes that climb and drop */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Generator")
+	float HeightDeviation = 0.1f;
+
+	/** Per platform whose headroom, landing zone or run-up is blocked by a building */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Generator")
+	float BlockedPlatform = -1.0f;
+
+	/** Per jump that fails validation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Generator")
+	float InvalidJump = -5.0f;
+};
+
+/** A layout solved for one seed, with the metrics it was scored on */
+USTRUCT(BlueprintType)
+struct PARKOURGENERATOR_API FParkourSeedVariant
+{
+	GENERATED_BODY()
+
+	/** Seed the path and the play area were solved with */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	int32 Seed = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator")
+	float Score = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Metrics")
+	int32 NumPlatforms = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Metrics")
+	float MeanJumpMargin = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Metrics")
+	float MinJumpMargin = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Metrics")
+	float JumpMarginDeviation = 0.0f;
+
+	/** Standard deviation of the platform heights (cm) */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Metrics")
+	float HeightDeviation = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Metrics")
+	int32 BlockedPlatforms = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Metrics")
+	int32 InvalidJumps = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Metrics")
+	int32 NumBuildings = 0;
+
+	/** Whether Buildings were solved for this seed, rather than being the play area's current buildings */
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Layout")
+	bool bSolvedEnvironment = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Layout")
+	TArray<FTransform> Platforms;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Layout")
+	TArray<bool> PlatformsOnRooftop;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Parkour Generator|Layout")
+	TArray<FBox> Buildings;
+
+	/**
+	 * Solve the path, and then the play area if given against the solved platforms, with Seed and score the result.
+	 * Creates no components, so it runs on worker threads. A path landing on the play area's rooftops is solved
+	 * against its current buildings, which are then kept rather than solved again
+	 */
+	static FParkourSeedVariant Evaluate(const AParkourPath& Path, const AParkourPlayArea* PlayArea, int32 Seed, const FParkourVariantWeights& Weights, float OccupancyCellSize);
+};
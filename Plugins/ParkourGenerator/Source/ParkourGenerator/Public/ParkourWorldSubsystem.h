@@ -0,0 +1,116 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Async/Future.h"
+#include "ParkourWorldSubsystem.generated.h"
+
+class AParkourPath;
+class AParkourPlayArea;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnParkourGenerationFinished, int32, RequestId);
+
+/**
+ * Parkour World Subsystem
+ *
+ * Generates paths and play areas at run time from a seed, so procedurally varied challenge runs can
+ * ship without baked geometry. Solves run on a worker thread, the resulting meshes are created on the
+ * game thread a few at a time so generation never takes more than FrameBudgetMs of a frame.
+ */
+UCLASS()
+class PARKOURGENERATOR_API UParkourWorldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Game thread time generation may use per frame (ms), initialized from the plugin settings */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Parkour Generator", meta = (ClampMin = "0.1"))
+	float FrameBudgetMs = 2.0f;
+
+	/** Broadcast once all meshes of a request exist */
+	UPROPERTY(BlueprintAssignable, Category = "Parkour Generator")
+	FOnParkourGenerationFinished OnGenerationFinished;
+
+	/**
+	 * Queue generation of a path and optionally a play area from a seed (0 = random), using their current
+	 * parameters. Requests are processed one after another. Returns the request id, INDEX_NONE if Path is null.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	int32 RequestGeneration(AParkourPath* Path, AParkourPlayArea* PlayArea, int32 Seed);
+
+	/**
+	 * Queue creation of the meshes a path and/or play area have queued (see bIncrementalGeneration),
+	 * nearest to the camera first. Returns the request id.
+	 */
+	int32 RequestMeshCreation(AParkourPath* Path, AParkourPlayArea* PlayArea);
+
+	/** Drop a queued or running request, meshes that already exist are kept */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void CancelGeneration(int32 RequestId);
+
+	/** Whether any request is queued or running */
+	UFUNCTION(BlueprintPure, Category = "Parkour Generator")
+	bool IsGenerating() const { return Requests.Num() > 0; }
+
+	// USubsystem / FTickableGameObject
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickableInEditor() const override { return true; }
+
+	/** Keeps the actors of running solves from being collected */
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+private:
+	enum class EGenerationStep : uint8
+	{
+		SolvePath,
+		SolveEnvironment,
+		CreateMeshes
+	};
+
+	/** Solver output, written on the worker thread and read once the solve is done */
+	struct FSolveResult
+	{
+		TArray<FTransform> Platforms;
+		TArray<bool> PlatformsOnRooftop;
+		TArray<FBox> Buildings;
+	};
+
+	struct FGenerationRequest
+	{
+		int32 Id = INDEX_NONE;
+		TWeakObjectPtr<AParkourPath> Path;
+		TWeakObjectPtr<AParkourPlayArea> PlayArea;
+		int32 PathSeed = 0;
+		int32 EnvironmentSeed = 0;
+		TArray<EGenerationStep> Steps;
+		int32 CurrentStep = 0;
+		TSharedPtr<FSolveResult, ESPMode::ThreadSafe> Result;
+		TFuture<void> Solve;
+
+		/** Actors the running solve reads, referenced until it returns */
+		AParkourPath* SolvePath = nullptr;
+		AParkourPlayArea* SolvePlayArea = nullptr;
+		bool bMeshesSorted = false;
+		bool bCancelled = false;
+	};
+
+	/** Start or finish the solve of the current step, returns true once it is done */
+	bool TickSolve(FGenerationRequest& Request, EGenerationStep Step);
+
+	/** Create meshes until the deadline, returns true once none are left */
+	bool TickCreateMeshes(FGenerationRequest& Request, double Deadline);
+
+	/** Camera location of the local player, or of the active level viewport in the editor */
+	bool GetViewLocation(FVector& OutLocation) const;
+
+	TArray<FGenerationRequest> Requests;
+	int32 NextRequestId = 0;
+
+	/** Whether navigation rebuilds are held back while requests are queued */
+	bool bNavigationBatchOpen = false;
+};
@@ -0,0 +1,37 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ParkourGeneratorEditor : ModuleRules
+{
+	public ParkourGeneratorEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"ParkourGenerator"
+			}
+		);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"InputCore",
+				"Slate",
+				"SlateCore",
+				"UnrealEd",
+				"EditorStyle",
+				"EditorSubsystem",
+				"LevelEditor",
+				"PropertyEditor",
+				"EditorFramework",
+				"ToolMenus"
+			}
+		);
+	}
+}
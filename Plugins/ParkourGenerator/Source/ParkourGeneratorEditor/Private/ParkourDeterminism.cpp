@@ -0,0 +1,187 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourDeterminism.h"
+#include "ParkourPath.h"
+#include "ParkourPlayArea.h"
+#include "ParkourLayout.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ParkourDeterminism
+{
+	struct FPathShape
+	{
+		const TCHAR* Name;
+		TArray<FVector> Points;
+	};
+
+	/** Path splines, all crossing the default 5000 x 5000 area at the origin */
+	static TArray<FPathShape> GetPathShapes()
+	{
+		return {
+			{TEXT("Straight"), {FVector(-2000, 0, 0), FVector(2000, 0, 0)}},
+			{TEXT("Curve"), {FVector(-2000, -1000, 0), FVector(-500, 1000, 100), FVector(500, -1000, 200), FVector(2000, 1000, 0)}},
+			{TEXT("Climb"), {FVector(-2000, 0, 0), FVector(-1000, 500, 300), FVector(0, 0, 600), FVector(1000, -500, 900), FVector(2000, 0, 1200)}}
+		};
+	}
+
+	static const int32 Seeds[] = {1, 7, 1234};
+
+	static const EParkourAreaShape AreaShapes[] = {EParkourAreaShape::Box, EParkourAreaShape::LShape, EParkourAreaShape::UShape, EParkourAreaShape::Custom};
+
+	static const EParkourEnvironmentStyle Styles[] = {EParkourEnvironmentStyle::Urban, EParkourEnvironmentStyle::Industrial, EParkourEnvironmentStyle::Abstract};
+
+	static FString GetCaseName(const FPathShape& PathShape, EParkourAreaShape AreaShape, EParkourEnvironmentStyle Style, EParkourPlacementMode Mode, bool bRooftops, int32 Seed)
+	{
+		return FString::Printf(TEXT("%s_%s_%s_%s%s_Seed%d"),
+			PathShape.Name,
+			*StaticEnum<EParkourAreaShape>()->GetNameStringByValue((int64)AreaShape),
+			*StaticEnum<EParkourEnvironmentStyle>()->GetNameStringByValue((int64)Style),
+			*StaticEnum<EParkourPlacementMode>()->GetNameStringByValue((int64)Mode),
+			bRooftops ? TEXT("_Rooftops") : TEXT(""),
+			Seed);
+	}
+
+	/** Solve one case in the order GenerateAll uses, or buildings first for a rooftop route */
+	static uint64 SolveCase(UWorld& World, const FPathShape& PathShape, EParkourAreaShape AreaShape, EParkourEnvironmentStyle Style, EParkourPlacementMode Mode, bool bRooftops, int32 Seed)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags = RF_Transient;
+
+		AParkourPath* Path = World.SpawnActor<AParkourPath>(AParkourPath::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		AParkourPlayArea* Area = World.SpawnActor<AParkourPlayArea>(AParkourPlayArea::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+
+		uint64 Fingerprint = 0;
+		if (Path && Area)
+		{
+			Path->PathSpline->ClearSplinePoints(false);
+			for (const FVector& Point : PathShape.Points)
+			{
+				Path->PathSpline->AddSplinePoint(Point, ESplineCoordinateSpace::Local, false);
+			}
+			Path->PathSpline->UpdateSpline();
+			Path->PlacementMode = Mode;
+			Path->bUseBuildingRooftops = bRooftops;
+			Path->RooftopSourceArea = bRooftops ? Area : nullptr;
+			Path->UpdatePathBVH();
+
+			Area->AreaShape = AreaShape;
+			Area->EnvironmentStyle = Style;
+			Area->ParkourPath = Path;
+
+			TArray<FTransform> Platforms;
+			TArray<bool> OnRooftop;
+			TArray<FBox> Buildings;
+
+			if (bRooftops)
+			{
+				Area->SolveBuildings(Seed, Buildings);
+				Area->GeneratedBuildingBoxes = Buildings;
+				Platforms = Path->SolvePlatforms(Seed, OnRooftop);
+			}
+			else
+			{
+				Platforms = Path->SolvePlatforms(Seed, OnRooftop);
+				Area->SolveBuildings(Seed, Buildings, nullptr, &Platforms);
+			}
+
+			Fingerprint = FParkourCompactLayout::MakeFingerprint(Platforms, OnRooftop, Buildings);
+		}
+
+		if (Path)
+		{
+			Path->Destroy();
+		}
+		if (Area)
+		{
+			Area->Destroy();
+		}
+
+		return Fingerprint;
+	}
+
+	static FString GetFullPath(const FString& FilePath)
+	{
+		return FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectDir(), FilePath) : FilePath;
+	}
+}
+
+void FParkourDeterminismCorpus::Run(UWorld& World, TArray<TPair<FString, uint64>>& OutFingerprints)
+{
+	using namespace ParkourDeterminism;
+
+	OutFingerprints.Reset();
+	const TArray<FPathShape> PathShapes = GetPathShapes();
+
+	for (int32 Seed : Seeds)
+	{
+		// Every path over every area shape, cycling through the styles
+		for (int32 PathIndex = 0; PathIndex < PathShapes.Num(); PathIndex++)
+		{
+			for (int32 ShapeIndex = 0; ShapeIndex < (int32)UE_ARRAY_COUNT(AreaShapes); ShapeIndex++)
+			{
+				const EParkourEnvironmentStyle Style = Styles[(PathIndex + ShapeIndex) % UE_ARRAY_COUNT(Styles)];
+				const FPathShape& PathShape = PathShapes[PathIndex];
+				OutFingerprints.Emplace(GetCaseName(PathShape, AreaShapes[ShapeIndex], Style, EParkourPlacementMode::Greedy, false, Seed),
+					SolveCase(World, PathShape, AreaShapes[ShapeIndex], Style, EParkourPlacementMode::Greedy, false, Seed));
+			}
+		}
+
+		// Optimal placement on every path
+		for (const FPathShape& PathShape : PathShapes)
+		{
+			OutFingerprints.Emplace(GetCaseName(PathShape, EParkourAreaShape::Box, EParkourEnvironmentStyle::Urban, EParkourPlacementMode::Optimal, false, Seed),
+				SolveCase(World, PathShape, EParkourAreaShape::Box, EParkourEnvironmentStyle::Urban, EParkourPlacementMode::Optimal, false, Seed));
+		}
+
+		// A rooftop route
+		const FPathShape& RooftopShape = PathShapes[1];
+		OutFingerprints.Emplace(GetCaseName(RooftopShape, EParkourAreaShape::Box, EParkourEnvironmentStyle::Urban, EParkourPlacementMode::Greedy, true, Seed),
+			SolveCase(World, RooftopShape, EParkourAreaShape::Box, EParkourEnvironmentStyle::Urban, EParkourPlacementMode::Greedy, true, Seed));
+	}
+}
+
+bool FParkourDeterminismCorpus::LoadGolden(const FString& FilePath, TMap<FString, uint64>& OutFingerprints)
+{
+	OutFingerprints.Reset();
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *ParkourDeterminism::GetFullPath(FilePath)))
+	{
+		return false;
+	}
+
+	for (const FString& Line : Lines)
+	{
+		TArray<FString> Fields;
+		Line.ParseIntoArrayWS(Fields);
+		if (Fields.Num() != 2 || Fields[0].StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		OutFingerprints.Add(Fields[0], FCString::Strtoui64(*Fields[1], nullptr, 16));
+	}
+
+	return true;
+}
+
+bool FParkourDeterminismCorpus::SaveGolden(const FString& FilePath, const TArray<TPair<FString, uint64>>& Fingerprints)
+{
+	FString Text = TEXT("# Parkour Generator layout fingerprints, see FParkourDeterminismCorpus") LINE_TERMINATOR;
+	for (const TPair<FString, uint64>& Case : Fingerprints)
+	{
+		Text += FString::Printf(TEXT("%s %s"), *Case.Key, *FParkourCompactLayout::FingerprintToString(Case.Value)) + LINE_TERMINATOR;
+	}
+
+	const FString FullPath = ParkourDeterminism::GetFullPath(FilePath);
+	if (!FFileHelper::SaveStringToFile(Text, *FullPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Failed to write golden fingerprints to %s"), *FullPath);
+		return false;
+	}
+
+	return true;
+}
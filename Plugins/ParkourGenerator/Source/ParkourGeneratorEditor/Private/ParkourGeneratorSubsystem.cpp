@@ -0,0 +1,875 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "ParkourGeneratorSubsystem.h"
+#include "ParkourPath.h"
+#include "ParkourPlayArea.h"
+#include "ParkourPathNetwork.h"
+#include "ParkourGeneratorSettings.h"
+#include "ParkourLayoutFile.h"
+#include "ParkourNavigationBatch.h"
+#include "ParkourDeterminism.h"
+#include "PreviewScene.h"
+#include "EngineUtils.h"
+#include "Editor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Async/ParallelFor.h"
+#include "Algo/StableSort.h"
+
+UWorld* UParkourGeneratorSubsystem::GetEditorWorld() const
+{
+	if (GEditor)
+	{
+		return GEditor->GetEditorWorldContext().World();
+	}
+	return nullptr;
+}
+
+AParkourPath* UParkourGeneratorSubsystem::SpawnParkourPath(const FVector& Location)
+{
+	UWorld* World = GetEditorWorld();
+	if (!World)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: No editor world available"));
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AParkourPath* NewPath = World->SpawnActor<AParkourPath>(AParkourPath::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+
+	if (NewPath)
+	{
+		// Apply default settings
+		const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+		if (Settings)
+		{
+			NewPath->MaxJumpHeight = Settings->DefaultMaxJumpHeight;
+			NewPath->MaxJumpDistance = Settings->DefaultMaxJumpDistance;
+			NewPath->JumpSafetyMargin = Settings->DefaultJumpSafetyMargin;
+			NewPath->PlatformWidth = Settings->DefaultPlatformWidth;
+			NewPath->PlatformDepth = Settings->DefaultPlatformDepth;
+			NewPath->PlatformThickness = Settings->DefaultPlatformThickness;
+		}
+
+		// Select the new actor
+		if (GEditor)
+		{
+			GEditor->SelectNone(true, true);
+			GEditor->SelectActor(NewPath, true, true);
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Spawned new Parkour Path at %s"), *Location.ToString());
+	}
+
+	return NewPath;
+}
+
+AParkourPlayArea* UParkourGeneratorSubsystem::SpawnPlayArea(const FVector& Location, const FVector& Dimensions)
+{
+	UWorld* World = GetEditorWorld();
+	if (!World)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: No editor world available"));
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AParkourPlayArea* NewArea = World->SpawnActor<AParkourPlayArea>(AParkourPlayArea::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+
+	if (NewArea)
+	{
+		NewArea->AreaDimensions = Dimensions;
+
+		// Apply default settings
+		const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+		if (Settings)
+		{
+			NewArea->BuildingDensity = Settings->DefaultBuildingDensity;
+			NewArea->PathClearance = Settings->DefaultPathClearance;
+		}
+
+		// Select the new actor
+		if (GEditor)
+		{
+			GEditor->SelectNone(true, true);
+			GEditor->SelectActor(NewArea, true, true);
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Spawned new Play Area at %s with dimensions %s"), *Location.ToString(), *Dimensions.ToString());
+	}
+
+	return NewArea;
+}
+
+void UParkourGeneratorSubsystem::SpawnCompleteParkourSetup(const FVector& Location, AParkourPath*& OutPath, AParkourPlayArea*& OutPlayArea)
+{
+	// Spawn play area first
+	OutPlayArea = SpawnPlayArea(Location, FVector(5000, 5000, 2000));
+
+	// Spawn path at center
+	OutPath = SpawnParkourPath(Location);
+
+	// Link them together
+	if (OutPlayArea && OutPath)
+	{
+		OutPlayArea->ParkourPath = OutPath;
+
+		// Select both
+		if (GEditor)
+		{
+			GEditor->SelectNone(true, true);
+			GEditor->SelectActor(OutPath, true, true);
+			GEditor->SelectActor(OutPlayArea, true, false);
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Spawned complete parkour setup"));
+	}
+}
+
+TArray<AParkourPath*> UParkourGeneratorSubsystem::GetAllParkourPaths() const
+{
+	TArray<AParkourPath*> Paths;
+
+	UWorld* World = GetEditorWorld();
+	if (World)
+	{
+		for (TActorIterator<AParkourPath> It(World); It; ++It)
+		{
+			Paths.Add(*It);
+		}
+	}
+
+	return Paths;
+}
+
+TArray<AParkourPlayArea*> UParkourGeneratorSubsystem::GetAllPlayAreas() const
+{
+	TArray<AParkourPlayArea*> Areas;
+
+	UWorld* World = GetEditorWorld();
+	if (World)
+	{
+		for (TActorIterator<AParkourPlayArea> It(World); It; ++It)
+		{
+			Areas.Add(*It);
+		}
+	}
+
+	return Areas;
+}
+
+TArray<AParkourPathNetwork*> UParkourGeneratorSubsystem::GetAllPathNetworks() const
+{
+	TArray<AParkourPathNetwork*> Networks;
+
+	UWorld* World = GetEditorWorld();
+	if (World)
+	{
+		for (TActorIterator<AParkourPathNetwork> It(World); It; ++It)
+		{
+			Networks.Add(*It);
+		}
+	}
+
+	return Networks;
+}
+
+FParkourGenerationReport UParkourGeneratorSubsystem::GenerateAllParkour()
+{
+	FParkourGenerationReport Report;
+	const double StartTime = Report.Start();
+	Report.Name = TEXT("GenerateAllParkour");
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+
+	TArray<AParkourPath*> Paths = GetAllParkourPaths();
+	TArray<AParkourPathNetwork*> Networks = GetAllPathNetworks();
+
+	// Branches of a network are generated by the network, which shares their junction platforms
+	for (AParkourPathNetwork* Network : Networks)
+	{
+		Network->GenerateNetwork();
+		Report.Accumulate(Network->LastGenerationReport);
+	}
+
+	for (AParkourPath* Path : Paths)
+	{
+		if (Path && !IsNetworkBranch(Networks, Path))
+		{
+			Path->GenerateParkour();
+			Report.Accumulate(Path->LastGenerationReport);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Generated parkour for %d paths"), Paths.Num());
+
+	FinishReport(Report, StartTime);
+	return Report;
+}
+
+void UParkourGeneratorSubsystem::ClearAllParkour()
+{
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+	TArray<AParkourPath*> Paths = GetAllParkourPaths();
+
+	for (AParkourPath* Path : Paths)
+	{
+		if (Path)
+		{
+			Path->ClearGeneratedParkour();
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Cleared parkour for %d paths"), Paths.Num());
+}
+
+FParkourGenerationReport UParkourGeneratorSubsystem::GenerateAllEnvironments()
+{
+	FParkourGenerationReport Report;
+	const double StartTime = Report.Start();
+	Report.Name = TEXT("GenerateAllEnvironments");
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+
+	GenerateAreas(Report);
+
+	FinishReport(Report, StartTime);
+	return Report;
+}
+
+void UParkourGeneratorSubsystem::GenerateAreas(FParkourGenerationReport& Report)
+{
+	TArray<AParkourPlayArea*> Areas = GetAllPlayAreas();
+
+	for (AParkourPlayArea* Area : Areas)
+	{
+		if (Area)
+		{
+			Area->GenerateEnvironment();
+			Report.Accumulate(Area->LastGenerationReport);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Generated environment for %d areas"), Areas.Num());
+}
+
+FParkourGenerationReport UParkourGeneratorSubsystem::UpdateEnvironmentsForPath(AParkourPath* Path)
+{
+	FParkourGenerationReport Report;
+	const double StartTime = Report.Start();
+	Report.Name = TEXT("UpdateEnvironmentsForPath");
+
+	if (!Path)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: No path to update environments for"));
+		return Report;
+	}
+
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+
+	int32 NumUpdated = 0;
+	for (AParkourPlayArea* Area : GetAllPlayAreas())
+	{
+		if (Area && Area->ParkourPath == Path)
+		{
+			Area->UpdateEnvironmentForPath();
+			Report.Accumulate(Area->LastGenerationReport);
+			NumUpdated++;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Updated environment for %d areas around %s"), NumUpdated, *Path->GetName());
+
+	FinishReport(Report, StartTime);
+	return Report;
+}
+
+void UParkourGeneratorSubsystem::ClearAllEnvironments()
+{
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+	TArray<AParkourPlayArea*> Areas = GetAllPlayAreas();
+
+	for (AParkourPlayArea* Area : Areas)
+	{
+		if (Area)
+		{
+			Area->ClearGeneratedEnvironment();
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Cleared environment for %d areas"), Areas.Num());
+}
+
+FParkourGenerationReport UParkourGeneratorSubsystem::GenerateEverything()
+{
+	FParkourGenerationReport Report;
+	const double StartTime = Report.Start();
+	Report.Name = TEXT("GenerateEverything");
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+
+	// Generate parkour first (so environment can avoid it), except paths that land on rooftops
+	TArray<AParkourPathNetwork*> Networks = GetAllPathNetworks();
+	TArray<AParkourPathNetwork*> RooftopNetworks;
+	for (AParkourPathNetwork* Network : Networks)
+	{
+		if (Network->UsesRooftops())
+		{
+			RooftopNetworks.Add(Network);
+		}
+		else
+		{
+			Network->GenerateNetwork();
+			Report.Accumulate(Network->LastGenerationReport);
+		}
+	}
+
+	TArray<AParkourPath*> RooftopPaths;
+	for (AParkourPath* Path : GetAllParkourPaths())
+	{
+		if (!Path || IsNetworkBranch(Networks, Path))
+		{
+			continue;
+		}
+
+		if (Path->bUseBuildingRooftops && Path->RooftopSourceArea)
+		{
+			RooftopPaths.Add(Path);
+		}
+		else
+		{
+			Path->GenerateParkour();
+			Report.Accumulate(Path->LastGenerationReport);
+		}
+	}
+
+	// Then generate environments
+	GenerateAreas(Report);
+
+	// Rooftop paths are solved against the new buildings
+	for (AParkourPathNetwork* Network : RooftopNetworks)
+	{
+		Network->GenerateNetwork();
+		Report.Accumulate(Network->LastGenerationReport);
+	}
+
+	for (AParkourPath* Path : RooftopPaths)
+	{
+		Path->GenerateParkour();
+		Report.Accumulate(Path->LastGenerationReport);
+	}
+
+	FinishReport(Report, StartTime);
+	return Report;
+}
+
+void UParkourGeneratorSubsystem::FinishReport(FParkourGenerationReport& Report, double StartTime) const
+{
+	if (UWorld* World = GetEditorWorld())
+	{
+		Report.Map = World->GetOutermost()->GetName();
+	}
+	Report.Finish(StartTime);
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: %s took %.1f ms (solve %.1f ms, meshes %.1f ms), %d components, %d triangles"),
+		*Report.Name, Report.TotalTimeMs, Report.SolveTimeMs, Report.MeshTimeMs, Report.Components, Report.Triangles);
+
+	const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+	if (Settings && !Settings->GenerationReportFile.IsEmpty())
+	{
+		Report.AppendToFile(Settings->GenerationReportFile);
+	}
+}
+
+bool UParkourGeneratorSubsystem::CheckDeterminism(const FString& GoldenFilePath, bool bRecord, TArray<FString>& OutMismatches)
+{
+	OutMismatches.Reset();
+
+	// A world of its own, so level content cannot change the layouts
+	FPreviewScene PreviewScene;
+	UWorld* World = PreviewScene.GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<TPair<FString, uint64>> Fingerprints;
+	FParkourDeterminismCorpus::Run(*World, Fingerprints);
+	const float TimeMs = FParkourGenerationReport::MillisecondsSince(StartTime);
+
+	if (bRecord)
+	{
+		UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Recording %d golden fingerprints to %s"), Fingerprints.Num(), *GoldenFilePath);
+		return FParkourDeterminismCorpus::SaveGolden(GoldenFilePath, Fingerprints);
+	}
+
+	// A missing file is a failure, not a first run, so a check can never pass by recording
+	TMap<FString, uint64> Golden;
+	if (!FParkourDeterminismCorpus::LoadGolden(GoldenFilePath, Golden))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ParkourGenerator: No golden fingerprints at %s, record them with bRecord"), *GoldenFilePath);
+		OutMismatches.Add(FString::Printf(TEXT("%s: golden file not found"), *GoldenFilePath));
+		return false;
+	}
+
+	int32 NumMatching = 0;
+	for (const TPair<FString, uint64>& Case : Fingerprints)
+	{
+		const uint64* Expected = Golden.Find(Case.Key);
+		if (!Expected)
+		{
+			OutMismatches.Add(FString::Printf(TEXT("%s: not in the golden file"), *Case.Key));
+		}
+		else if (*Expected != Case.Value)
+		{
+			OutMismatches.Add(FString::Printf(TEXT("%s: expected %s, got %s"), *Case.Key,
+				*FParkourCompactLayout::FingerprintToString(*Expected), *FParkourCompactLayout::FingerprintToString(Case.Value)));
+		}
+		else
+		{
+			NumMatching++;
+		}
+		Golden.Remove(Case.Key);
+	}
+
+	for (const TPair<FString, uint64>& Missing : Golden)
+	{
+		OutMismatches.Add(FString::Printf(TEXT("%s: no longer in the corpus"), *Missing.Key));
+	}
+
+	for (const FString& Mismatch : OutMismatches)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Layout changed, %s"), *Mismatch);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: %d of %d corpus layouts match %s (%.1f ms)"),
+		NumMatching, Fingerprints.Num(), *GoldenFilePath, TimeMs);
+
+	return OutMismatches.Num() == 0;
+}
+
+bool UParkourGeneratorSubsystem::AppendGenerationReport(const FParkourGenerationReport& Report, const FString& FilePath)
+{
+	return Report.AppendToFile(FilePath);
+}
+
+bool UParkourGeneratorSubsystem::IsNetworkBranch(const TArray<AParkourPathNetwork*>& Networks, const AParkourPath* Path)
+{
+	for (const AParkourPathNetwork* Network : Networks)
+	{
+		if (Network->ContainsBranch(Path))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UParkourGeneratorSubsystem::ClearEverything()
+{
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+
+	ClearAllEnvironments();
+	ClearAllParkour();
+}
+
+void UParkourGeneratorSubsystem::BakeEverything()
+{
+	// A bake that succeeded swapped the procedural meshes for baked components
+	int32 NumBakedPaths = 0;
+	for (AParkourPath* Path : GetAllParkourPaths())
+	{
+		if (Path && Path->GeneratedPlatformMeshes.Num() > 0)
+		{
+			Path->BakeToStaticMesh();
+			NumBakedPaths += Path->GeneratedPlatformMeshes.Num() == 0 && Path->BakedPlatformMeshes.Num() > 0 ? 1 : 0;
+		}
+	}
+
+	int32 NumBakedAreas = 0;
+	for (AParkourPlayArea* Area : GetAllPlayAreas())
+	{
+		if (Area && (Area->GeneratedBuildingMeshes.Num() > 0 || Area->GeneratedFloorMeshes.Num() > 0))
+		{
+			Area->BakeToStaticMeshes();
+			NumBakedAreas += Area->BakedEnvironmentMeshes.Num() > 0 ? 1 : 0;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Baked %d paths and %d areas"), NumBakedPaths, NumBakedAreas);
+}
+
+bool UParkourGeneratorSubsystem::ExportLayout(AParkourPath* Path, AParkourPlayArea* PlayArea, const FString& FilePath)
+{
+	if (!Path)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: ExportLayout needs a path"));
+		return false;
+	}
+
+	FParkourLayoutFileParams Params;
+	FMemory::Memzero(Params);
+	Params.MaxJumpHeight = Path->MaxJumpHeight;
+	Params.MaxJumpDistance = Path->MaxJumpDistance;
+	Params.JumpSafetyMargin = Path->JumpSafetyMargin;
+	Params.PlatformWidth = Path->PlatformWidth;
+	Params.PlatformDepth = Path->PlatformDepth;
+	Params.PlatformThickness = Path->PlatformThickness;
+	Params.PathSeed = Path->CompactLayout.Seed;
+
+	TArray<FParkourLayoutFilePlatform> Platforms;
+	Platforms.Reserve(Path->GeneratedPlatformTransforms.Num());
+	for (int32 i = 0; i < Path->GeneratedPlatformTransforms.Num(); i++)
+	{
+		const FTransform& Transform = Path->GeneratedPlatformTransforms[i];
+		const bool bRooftop = Path->GeneratedPlatformOnRooftop.IsValidIndex(i) && Path->GeneratedPlatformOnRooftop[i];
+		const FVector Location = Transform.GetLocation();
+		const FQuat Rotation = Transform.GetRotation();
+		const FVector Scale = Transform.GetScale3D();
+
+		FParkourLayoutFilePlatform& Platform = Platforms.AddZeroed_GetRef();
+		Platform.Location[0] = Location.X;
+		Platform.Location[1] = Location.Y;
+		Platform.Location[2] = Location.Z;
+		Platform.Rotation[0] = Rotation.X;
+		Platform.Rotation[1] = Rotation.Y;
+		Platform.Rotation[2] = Rotation.Z;
+		Platform.Rotation[3] = Rotation.W;
+		Platform.Size[0] = Path->PlatformDepth * Scale.Y;
+		Platform.Size[1] = Path->PlatformWidth * Scale.X;
+		Platform.Size[2] = bRooftop ? 0.0f : Path->PlatformThickness;
+	}
+
+	TArray<FParkourLayoutFilePathSample> PathSamples;
+	if (Path->PathSpline)
+	{
+		const float SplineLength = Path->PathSpline->GetSplineLength();
+		const int32 NumSamples = FMath::FloorToInt(SplineLength / ParkourLayoutFile::PathSampleInterval) + 2;
+		PathSamples.Reserve(NumSamples);
+
+		for (int32 i = 0; i < NumSamples; i++)
+		{
+			const float Distance = FMath::Min(i * ParkourLayoutFile::PathSampleInterval, SplineLength);
+			const FVector Location = Path->PathSpline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+
+			FParkourLayoutFilePathSample& Sample = PathSamples.AddZeroed_GetRef();
+			Sample.Location[0] = Location.X;
+			Sample.Location[1] = Location.Y;
+			Sample.Location[2] = Location.Z;
+			Sample.Distance = Distance;
+		}
+	}
+
+	TArray<FParkourLayoutFileBuilding> Buildings;
+	if (PlayArea)
+	{
+		Params.EnvironmentSeed = PlayArea->CompactLayout.Seed;
+		Params.AreaDimensions[0] = PlayArea->AreaDimensions.X;
+		Params.AreaDimensions[1] = PlayArea->AreaDimensions.Y;
+		Params.AreaDimensions[2] = PlayArea->AreaDimensions.Z;
+		Params.PathClearance = PlayArea->PathClearance;
+		Params.BuildingDensity = PlayArea->BuildingDensity;
+		Params.AreaShape = (uint8)PlayArea->AreaShape;
+		Params.EnvironmentStyle = (uint8)PlayArea->EnvironmentStyle;
+		Params.Flags = 0x1 | (PlayArea->CompactLayout.bFloor ? 0x2 : 0x0);
+
+		Buildings.Reserve(PlayArea->GeneratedBuildingBoxes.Num());
+		for (const FBox& Box : PlayArea->GeneratedBuildingBoxes)
+		{
+			FParkourLayoutFileBuilding& Building = Buildings.AddZeroed_GetRef();
+			Building.Min[0] = Box.Min.X;
+			Building.Min[1] = Box.Min.Y;
+			Building.Min[2] = Box.Min.Z;
+			Building.Max[0] = Box.Max.X;
+			Building.Max[1] = Box.Max.Y;
+			Building.Max[2] = Box.Max.Z;
+		}
+	}
+
+	TArray<uint8> FileData;
+	FParkourLayoutWriter::Write(Params, Platforms, Buildings, PathSamples, FileData);
+
+	if (!FFileHelper::SaveArrayToFile(FileData, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: Failed to write layout file %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Exported %d platforms and %d buildings to %s"), Platforms.Num(), Buildings.Num(), *FilePath);
+	return true;
+}
+
+bool UParkourGeneratorSubsystem::ImportLayout(const FString& FilePath, AParkourPath* Path, AParkourPlayArea* PlayArea)
+{
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+
+	// Map the file and read it in place, only fall back to loading it when mapping is not supported
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*FilePath));
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+
+	TArray<uint8> LoadedData;
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(LoadedData, *FilePath))
+	{
+		Data = LoadedData.GetData();
+		DataSize = LoadedData.Num();
+	}
+
+	FParkourLayoutView View;
+	if (!View.Initialize(Data, DataSize))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: %s is not a valid layout file"), *FilePath);
+		return false;
+	}
+
+	const FParkourLayoutFileParams& Params = View.GetHeader().Params;
+
+	if (Path)
+	{
+		Path->MaxJumpHeight = Params.MaxJumpHeight;
+		Path->MaxJumpDistance = Params.MaxJumpDistance;
+		Path->JumpSafetyMargin = Params.JumpSafetyMargin;
+		Path->PlatformWidth = Params.PlatformWidth;
+		Path->PlatformDepth = Params.PlatformDepth;
+		Path->PlatformThickness = Params.PlatformThickness;
+
+		TArray<FTransform> PlatformTransforms;
+		TArray<bool> PlatformsOnRooftop;
+		PlatformTransforms.Reserve(View.NumPlatforms());
+		PlatformsOnRooftop.Reserve(View.NumPlatforms());
+		for (int32 i = 0; i < View.NumPlatforms(); i++)
+		{
+			const FParkourLayoutFilePlatform& Platform = View.GetPlatform(i);
+			const FVector Scale(
+				Params.PlatformWidth > 0 ? Platform.Size[1] / Params.PlatformWidth : 1.0f,
+				Params.PlatformDepth > 0 ? Platform.Size[0] / Params.PlatformDepth : 1.0f,
+				1.0f
+			);
+
+			PlatformTransforms.Add(FTransform(
+				FQuat(Platform.Rotation[0], Platform.Rotation[1], Platform.Rotation[2], Platform.Rotation[3]),
+				FVector(Platform.Location[0], Platform.Location[1], Platform.Location[2]),
+				Scale
+			));
+			PlatformsOnRooftop.Add(Platform.Size[2] <= 0.0f);
+		}
+
+		Path->ApplyPlatformLayout(PlatformTransforms, Params.PathSeed, PlatformsOnRooftop);
+	}
+
+	if (PlayArea && (Params.Flags & 0x1))
+	{
+		PlayArea->AreaDimensions = FVector(Params.AreaDimensions[0], Params.AreaDimensions[1], Params.AreaDimensions[2]);
+		PlayArea->PathClearance = Params.PathClearance;
+		PlayArea->BuildingDensity = Params.BuildingDensity;
+		PlayArea->AreaShape = (EParkourAreaShape)Params.AreaShape;
+		PlayArea->EnvironmentStyle = (EParkourEnvironmentStyle)Params.EnvironmentStyle;
+
+		TArray<FBox> BuildingBoxes;
+		BuildingBoxes.Reserve(View.NumBuildings());
+		for (int32 i = 0; i < View.NumBuildings(); i++)
+		{
+			const FParkourLayoutFileBuilding& Building = View.GetBuilding(i);
+			BuildingBoxes.Add(FBox(
+				FVector(Building.Min[0], Building.Min[1], Building.Min[2]),
+				FVector(Building.Max[0], Building.Max[1], Building.Max[2])
+			));
+		}
+
+		PlayArea->ApplyBuildingLayout(BuildingBoxes, (Params.Flags & 0x2) != 0, Params.EnvironmentSeed);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Imported %d platforms and %d buildings from %s"), View.NumPlatforms(), View.NumBuildings(), *FilePath);
+	return true;
+}
+
+bool UParkourGeneratorSubsystem::AnalyzeRoutes(AParkourPath* Path, int32 NumAlternateRoutes, FParkourRouteAnalysis& OutAnalysis)
+{
+	OutAnalysis = FParkourRouteAnalysis();
+
+	if (!Path || Path->GeneratedPlatformTransforms.Num() < 2)
+	{
+		return false;
+	}
+
+	const double BuildStart = FPlatformTime::Seconds();
+
+	FParkourJumpGraph Graph;
+	Graph.Build(*Path, Path->GeneratedPlatformTransforms);
+
+	const double QueryStart = FPlatformTime::Seconds();
+
+	const int32 Start = 0;
+	const int32 Goal = Graph.NumNodes() - 1;
+	const bool bReachable = Graph.FindRoute(Start, Goal, EParkourRouteMetric::Shortest, OutAnalysis.ShortestRoute);
+	if (bReachable)
+	{
+		Graph.FindRoute(Start, Goal, EParkourRouteMetric::Safest, OutAnalysis.SafestRoute);
+		Graph.FindAlternateRoutes(Start, Goal, FMath::Max(NumAlternateRoutes, 0), OutAnalysis.AlternateRoutes);
+	}
+	Graph.FindShortcuts(1, OutAnalysis.Shortcuts);
+
+	const double QueryEnd = FPlatformTime::Seconds();
+
+	OutAnalysis.NumPlatforms = Graph.NumNodes();
+	OutAnalysis.NumJumps = Graph.NumEdges();
+	OutAnalysis.BuildTimeMs = (QueryStart - BuildStart) * 1000.0;
+	OutAnalysis.QueryTimeMs = (QueryEnd - QueryStart) * 1000.0;
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Jump graph of %s has %d platforms, %d jumps, %d shortcuts (build %.2f ms, queries %.2f ms)"),
+		*Path->GetName(), OutAnalysis.NumPlatforms, OutAnalysis.NumJumps, OutAnalysis.Shortcuts.Num(), OutAnalysis.BuildTimeMs, OutAnalysis.QueryTimeMs);
+
+	return bReachable;
+}
+
+bool UParkourGeneratorSubsystem::ValidatePath(AParkourPath* Path, TArray<int32>& OutInvalidJumpIndices)
+{
+	OutInvalidJumpIndices.Empty();
+
+	if (!Path || Path->GeneratedPlatformTransforms.Num() < 2)
+	{
+		return true; // Nothing to validate
+	}
+
+	// Only jumps changed since the path was last validated are checked again
+	OutInvalidJumpIndices = Path->UpdateJumpValidation().GetInvalidJumps();
+
+	return OutInvalidJumpIndices.Num() == 0;
+}
+
+bool UParkourGeneratorSubsystem::ValidateClearance(AParkourPath* Path, TArray<FParkourClearanceIssue>& OutIssues)
+{
+	OutIssues.Empty();
+
+	if (!Path || Path->GeneratedPlatformTransforms.Num() == 0)
+	{
+		return true; // Nothing to validate
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Only buildings around the platforms are voxelized
+	const FBox Bounds = Path->GetClearanceBounds(Path->GeneratedPlatformTransforms);
+	TArray<FBox> Buildings;
+	for (AParkourPlayArea* Area : GetAllPlayAreas())
+	{
+		for (const FBox& Building : Area->GeneratedBuildingBoxes)
+		{
+			if (Building.Intersect(Bounds))
+			{
+				Buildings.Add(Building);
+			}
+		}
+	}
+
+	const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+	FParkourOccupancyGrid Grid;
+	Grid.Build(Bounds, Settings ? Settings->OccupancyCellSize : 25.0f, Buildings);
+
+	const bool bClear = Path->FindClearanceIssues(Grid, Path->GeneratedPlatformTransforms, OutIssues);
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: %d of %d platforms of %s lack clearance (%d buildings, %.0f cm cells, %.2f ms)"),
+		OutIssues.Num(), Path->GeneratedPlatformTransforms.Num(), *Path->GetName(), Buildings.Num(), Grid.GetCellSize(),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return bClear;
+}
+
+bool UParkourGeneratorSubsystem::ExploreSeedVariants(AParkourPath* Path, AParkourPlayArea* PlayArea, int32 FirstSeed, int32 NumVariants, int32 TopK,
+	const FParkourVariantWeights& Weights, TArray<FParkourSeedVariant>& OutVariants)
+{
+	OutVariants.Empty();
+
+	if (!Path || !Path->PathSpline || Path->PathSpline->GetNumberOfSplinePoints() < 2 || NumVariants <= 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: ExploreSeedVariants needs a path with at least two spline points"));
+		return false;
+	}
+
+	// Buildings are solved against the area's path and this path's platforms, which only match for the same path
+	if (PlayArea && PlayArea->ParkourPath != Path)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: ExploreSeedVariants needs a play area that avoids %s, %s does not"), *Path->GetName(), *PlayArea->GetName());
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Worker threads query the path BVH, it has to match the spline before the solves start
+	Path->UpdatePathBVH();
+
+	// Seed 0 stands for a random layout
+	TArray<int32> Seeds;
+	Seeds.Reserve(NumVariants);
+	for (int32 Seed = FirstSeed; Seeds.Num() < NumVariants; Seed++)
+	{
+		if (Seed != 0)
+		{
+			Seeds.Add(Seed);
+		}
+	}
+
+	const UParkourGeneratorSettings* Settings = UParkourGeneratorSettings::Get();
+	const float CellSize = Settings ? Settings->OccupancyCellSize : 25.0f;
+
+	TArray<FParkourSeedVariant> Variants;
+	Variants.SetNum(Seeds.Num());
+	ParallelFor(Seeds.Num(), [&](int32 i)
+	{
+		Variants[i] = FParkourSeedVariant::Evaluate(*Path, PlayArea, Seeds[i], Weights, CellSize);
+	});
+
+	// Equal scores stay in seed order, so the same call always returns the same variants
+	Algo::StableSort(Variants, [](const FParkourSeedVariant& A, const FParkourSeedVariant& B)
+	{
+		return A.Score > B.Score;
+	});
+	Variants.SetNum(FMath::Clamp(TopK, 1, Variants.Num()));
+	OutVariants = MoveTemp(Variants);
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Explored %d seed variants of %s in %.1f ms, best is seed %d with score %.3f"),
+		Seeds.Num(), *Path->GetName(), (FPlatformTime::Seconds() - StartTime) * 1000.0, OutVariants[0].Seed, OutVariants[0].Score);
+
+	return true;
+}
+
+void UParkourGeneratorSubsystem::CommitSeedVariant(AParkourPath* Path, AParkourPlayArea* PlayArea, const FParkourSeedVariant& Variant)
+{
+	if (!Path)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: CommitSeedVariant needs a path"));
+		return;
+	}
+
+	if (PlayArea && Variant.bSolvedEnvironment && PlayArea->ParkourPath != Path)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ParkourGenerator: CommitSeedVariant needs a play area that avoids %s, %s does not"), *Path->GetName(), *PlayArea->GetName());
+		return;
+	}
+
+	FParkourNavigationBatch NavigationBatch(GetEditorWorld());
+
+	// The seeds stay on the actors, so generating again gives the same layout. Platforms go first, as they were solved
+	Path->RandomSeed = Variant.Seed;
+	Path->ApplyPlatformLayout(Variant.Platforms, Variant.Seed, Variant.PlatformsOnRooftop);
+
+	if (PlayArea && Variant.bSolvedEnvironment)
+	{
+		PlayArea->EnvironmentSeed = Variant.Seed;
+		PlayArea->ApplyBuildingLayout(Variant.Buildings, PlayArea->bGenerateFloor, Variant.Seed);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ParkourGenerator: Committed seed %d to %s (%d platforms, %d buildings)"),
+		Variant.Seed, *Path->GetName(), Variant.NumPlatforms, Variant.bSolvedEnvironment ? Variant.NumBuildings : 0);
+}
@@ -0,0 +1,64 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "ParkourPath.h"
+#include "ParkourJumpGraph.h"
+#include "ParkourReachabilityTable.h"
+#include "PreviewScene.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParkourJumpGraphLongDropTest, "ParkourGenerator.JumpGraph.LongDrop",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FParkourJumpGraphLongDropTest::RunTest(const FString& Parameters)
+{
+	FPreviewScene PreviewScene;
+	UWorld* World = PreviewScene.GetWorld();
+	if (!TestNotNull(TEXT("Preview world"), World))
+	{
+		return false;
+	}
+
+	UParkourReachabilityTable* Table = NewObject<UParkourReachabilityTable>(GetTransientPackage());
+	Table->Bake();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags = RF_Transient;
+	AParkourPath* Path = World->SpawnActor<AParkourPath>(AParkourPath::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	if (!TestNotNull(TEXT("Path"), Path))
+	{
+		return false;
+	}
+	Path->ReachabilityTable = Table;
+
+	// Farther than a jump to the same height, reachable only with a drop
+	const float Reach = Path->GetMaxJumpReach();
+	TestTrue(TEXT("Drops reach beyond the safe jump distance"), Reach > Path->GetSafeJumpDistance());
+
+	const FVector From(0.0f, 0.0f, 0.0f);
+	FVector To(Reach * 0.99f, 0.0f, 0.0f);
+	while (!Path->IsJumpValid(From, To) && To.Z > -Table->MaxDrop)
+	{
+		To.Z -= Table->HeightResolution;
+	}
+	if (!TestTrue(TEXT("The table allows the long drop"), Path->IsJumpValid(From, To)))
+	{
+		return false;
+	}
+
+	TArray<FTransform> Platforms;
+	Platforms.Add(FTransform(From));
+	Platforms.Add(FTransform(To));
+
+	FParkourJumpGraph Graph;
+	Graph.Build(*Path, Platforms);
+
+	const bool bFound = Graph.GetEdges(0).ContainsByPredicate([](const FParkourJumpGraph::FEdge& Edge) { return Edge.To == 1; });
+	TestTrue(TEXT("The jump graph has the long drop"), bFound);
+
+	Path->Destroy();
+	return true;
+}
+
+#endif
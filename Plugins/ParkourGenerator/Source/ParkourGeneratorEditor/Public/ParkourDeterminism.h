@@ -0,0 +1,30 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * Determinism Corpus
+ *
+ * A fixed set of paths, area shapes, environment styles, placement modes and seeds. Each case is solved
+ * with class default settings in a world of its own, so neither level content nor project settings affect
+ * it, and its layout is fingerprinted (FParkourCompactLayout::GetFingerprint). FRandomStream call order,
+ * float math and spline evaluation all feed into the fingerprints. A change that leaves them equal to
+ * golden values recorded before it leaves every layout the same at storage precision.
+ */
+class PARKOURGENERATOREDITOR_API FParkourDeterminismCorpus
+{
+public:
+	/** Solve every case in World (spawning and destroying transient actors) and return the fingerprints by case name, in corpus order */
+	static void Run(UWorld& World, TArray<TPair<FString, uint64>>& OutFingerprints);
+
+	/**
+	 * Golden files hold one "<case> <16 hex digits>" line per case, lines starting with # are comments.
+	 * Relative paths are relative to the project directory.
+	 */
+	static bool LoadGolden(const FString& FilePath, TMap<FString, uint64>& OutFingerprints);
+	static bool SaveGolden(const FString& FilePath, const TArray<TPair<FString, uint64>>& Fingerprints);
+};
@@ -0,0 +1,161 @@
+// Copyright ParkourGeneratorPro. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "ParkourJumpGraph.h"
+#include "ParkourGenerationReport.h"
+#include "ParkourOccupancyGrid.h"
+#include "ParkourSeedVariant.h"
+#include "ParkourGeneratorSubsystem.generated.h"
+
+class AParkourPath;
+class AParkourPlayArea;
+class AParkourPathNetwork;
+
+/**
+ * Parkour Generator Editor Subsystem
+ *
+ * Provides Blueprint-callable functions for spawning and managing parkour generator actors.
+ */
+UCLASS()
+class PARKOURGENERATOREDITOR_API UParkourGeneratorSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== SPAWNING ==========
+
+	/** Spawn a new Parkour Path at the given location */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	AParkourPath* SpawnParkourPath(const FVector& Location = FVector::ZeroVector);
+
+	/** Spawn a new Play Area at the given location */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	AParkourPlayArea* SpawnPlayArea(const FVector& Location = FVector::ZeroVector, const FVector& Dimensions = FVector(5000, 5000, 2000));
+
+	/** Spawn a complete parkour setup (Path + Play Area linked together) */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void SpawnCompleteParkourSetup(const FVector& Location, AParkourPath*& OutPath, AParkourPlayArea*& OutPlayArea);
+
+	// ========== FINDING ==========
+
+	/** Find all Parkour Paths in the current level */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	TArray<AParkourPath*> GetAllParkourPaths() const;
+
+	/** Find all Play Areas in the current level */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	TArray<AParkourPlayArea*> GetAllPlayAreas() const;
+
+	/** Find all Path Networks in the current level */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	TArray<AParkourPathNetwork*> GetAllPathNetworks() const;
+
+	// ========== GENERATION ==========
+	// Generate* calls return what they cost, summed over all actors, and append it to the report file in the settings
+
+	/** Generate parkour for all paths in the level */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	FParkourGenerationReport GenerateAllParkour();
+
+	/** Clear all generated parkour in the level */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void ClearAllParkour();
+
+	/** Generate environment for all play areas */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	FParkourGenerationReport GenerateAllEnvironments();
+
+	/** Clear all generated environments */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void ClearAllEnvironments();
+
+	/** After editing Path, update the environment of every play area that keeps clear of it, near the changes only */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	FParkourGenerationReport UpdateEnvironmentsForPath(AParkourPath* Path);
+
+	/** Generate everything (parkour + environments) */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	FParkourGenerationReport GenerateEverything();
+
+	/** Clear everything */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void ClearEverything();
+
+	/** Bake all generated platforms and environments into static mesh assets */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void BakeEverything();
+
+	// ========== LAYOUT EXCHANGE ==========
+
+	/** Export the generated layout of a path (and optional play area) to a flat binary .pklayout file */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	bool ExportLayout(AParkourPath* Path, AParkourPlayArea* PlayArea, const FString& FilePath);
+
+	/** Import a .pklayout file into a path (and optional play area), rebuilding meshes without solving */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	bool ImportLayout(const FString& FilePath, AParkourPath* Path, AParkourPlayArea* PlayArea);
+
+	// ========== UTILITY ==========
+
+	/** Validate that all jumps in a path are achievable */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	bool ValidatePath(AParkourPath* Path, TArray<int32>& OutInvalidJumpIndices);
+
+	/**
+	 * Check that no generated building blocks the headroom, landing zone or run-up of a path's platforms,
+	 * in one pass over an occupancy grid of the buildings around the path
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	bool ValidateClearance(AParkourPath* Path, TArray<FParkourClearanceIssue>& OutIssues);
+
+	/**
+	 * Analyse level flow over the jump graph of a path: shortest and safest route from the first to the
+	 * last platform, alternate routes and shortcuts that skip sections of the generated chain
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	bool AnalyzeRoutes(AParkourPath* Path, int32 NumAlternateRoutes, FParkourRouteAnalysis& OutAnalysis);
+
+	// ========== SEED VARIANTS ==========
+
+	/**
+	 * Solve NumVariants seeds from FirstSeed (0 is skipped) of a path and optionally its play area in parallel,
+	 * without creating components, and return the TopK by score, best first. The play area has to avoid the path
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	bool ExploreSeedVariants(AParkourPath* Path, AParkourPlayArea* PlayArea, int32 FirstSeed, int32 NumVariants, int32 TopK,
+		const FParkourVariantWeights& Weights, TArray<FParkourSeedVariant>& OutVariants);
+
+	/** Create the layout of a variant found by ExploreSeedVariants and keep its seed on the path and play area */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	void CommitSeedVariant(AParkourPath* Path, AParkourPlayArea* PlayArea, const FParkourSeedVariant& Variant);
+
+	// ========== DETERMINISM ==========
+
+	/**
+	 * Solve the determinism corpus (FParkourDeterminismCorpus) in a preview world and compare the layout
+	 * fingerprints with a golden file. With bRecord the fingerprints are written to it instead. Returns false
+	 * if the file is missing or any case changed, listed in OutMismatches
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	bool CheckDeterminism(const FString& GoldenFilePath, bool bRecord, TArray<FString>& OutMismatches);
+
+	/** Append a report to a .json or .csv file, see FParkourGenerationReport::AppendToFile */
+	UFUNCTION(BlueprintCallable, Category = "Parkour Generator")
+	bool AppendGenerationReport(const FParkourGenerationReport& Report, const FString& FilePath);
+
+	/** Get the editor world */
+	UWorld* GetEditorWorld() const;
+
+private:
+	/** Whether Path is generated by one of Networks */
+	static bool IsNetworkBranch(const TArray<AParkourPathNetwork*>& Networks, const AParkourPath* Path);
+
+	/** Generate the environment of all play areas, adding their costs to Report */
+	void GenerateAreas(FParkourGenerationReport& Report);
+
+	/** Finish a summed up report, log it and append it to the report file in the settings */
+	void FinishReport(FParkourGenerationReport& Report, double StartTime) const;
+};